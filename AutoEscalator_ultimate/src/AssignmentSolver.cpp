@@ -0,0 +1,62 @@
+#include "AssignmentSolver.h"
+#include <algorithm>
+#include <limits>
+
+const std::vector<int>& AssignmentSolver::solve(const std::vector<SimTime>& cost, int rows, int cols) {
+    const SimTime INF = std::numeric_limits<SimTime>::max() / 4;
+    rowPotential.assign(rows + 1, 0);
+    colPotential.assign(cols + 1, 0);
+    colOwner.assign(cols + 1, 0);
+    previousCol.assign(cols + 1, 0);
+
+    // 逐行加入，沿最短增广路调整势能；下标从 1 开始，第 0 列作为虚拟起点
+    for (int row = 1; row <= rows; ++row) {
+        colOwner[0] = row;
+        int col = 0;
+        minSlack.assign(cols + 1, INF);
+        visited.assign(cols + 1, 0);
+
+        do {
+            visited[col] = 1;
+            int owner = colOwner[col];
+            SimTime delta = INF;
+            int nextCol = 0;
+            for (int j = 1; j <= cols; ++j) {
+                if (visited[j]) continue;
+                SimTime slack = cost[static_cast<size_t>(owner - 1) * cols + (j - 1)]
+                              - rowPotential[owner] - colPotential[j];
+                if (slack < minSlack[j]) {
+                    minSlack[j] = slack;
+                    previousCol[j] = col;
+                }
+                if (minSlack[j] < delta) {
+                    delta = minSlack[j];
+                    nextCol = j;
+                }
+            }
+            for (int j = 0; j <= cols; ++j) {
+                if (visited[j]) {
+                    rowPotential[colOwner[j]] += delta;
+                    colPotential[j] -= delta;
+                } else {
+                    minSlack[j] -= delta;
+                }
+            }
+            col = nextCol;
+        } while (colOwner[col] != 0);
+
+        do {
+            int prev = previousCol[col];
+            colOwner[col] = colOwner[prev];
+            col = prev;
+        } while (col != 0);
+    }
+
+    assignment.assign(rows, -1);
+    for (int j = 1; j <= cols; ++j) {
+        if (colOwner[j] != 0) {
+            assignment[colOwner[j] - 1] = j - 1;
+        }
+    }
+    return assignment;
+}
@@ -0,0 +1,712 @@
+#include "BatchRunner.h"
+#include "Constants.h"
+#include "Logger.h"
+#include "ElevatorFleet.h"
+#include "LiveStateSegment.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <algorithm>
+
+namespace {
+    bool parseStrategy(const std::string& name, ElevatorStrategy& strategy) {
+        if (name == "nearest" || name == "nearest_first") {
+            strategy = ElevatorStrategy::NEAREST_FIRST;
+        } else if (name == "scan") {
+            strategy = ElevatorStrategy::SCAN;
+        } else if (name == "look") {
+            strategy = ElevatorStrategy::LOOK;
+        } else if (name == "destination" || name == "destination_dispatch") {
+            strategy = ElevatorStrategy::DESTINATION_DISPATCH;
+        } else if (name == "rollout") {
+            strategy = ElevatorStrategy::ROLLOUT;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    const char* strategyKey(ElevatorStrategy strategy) {
+        switch (strategy) {
+            case ElevatorStrategy::NEAREST_FIRST: return "nearest";
+            case ElevatorStrategy::SCAN: return "scan";
+            case ElevatorStrategy::LOOK: return "look";
+            case ElevatorStrategy::DESTINATION_DISPATCH: return "destination";
+            case ElevatorStrategy::ROLLOUT: return "rollout";
+        }
+        return "nearest";
+    }
+
+    const char* priorityKey(PriorityClass priority) {
+        switch (priority) {
+            case PriorityClass::EMERGENCY: return "emergency";
+            case PriorityClass::ACCESSIBILITY: return "accessibility";
+            case PriorityClass::NORMAL: return "normal";
+        }
+        return "normal";
+    }
+
+    const char* stateName(ElevatorState state) {
+        switch (state) {
+            case ElevatorState::IDLE: return "空闲";
+            case ElevatorState::MOVING_UP: return "上行";
+            case ElevatorState::MOVING_DOWN: return "下行";
+            case ElevatorState::STOPPED: return "停止";
+        }
+        return "未知";
+    }
+
+    const char* metricKey(JourneyLatency::Metric metric) {
+        switch (metric) {
+            case JourneyLatency::WAIT: return "wait";
+            case JourneyLatency::RIDE: return "ride";
+            case JourneyLatency::JOURNEY: return "journey";
+            default: return "";
+        }
+    }
+
+    void writeSummaryJson(std::ostream& out, const LatencyHistogram& histogram) {
+        LatencySummary summary = LatencySummary::of(histogram);
+        out << "{\"count\": " << summary.count << ", \"p50\": " << summary.p50
+            << ", \"p90\": " << summary.p90 << ", \"p99\": " << summary.p99
+            << ", \"max\": " << summary.max << "}";
+    }
+
+    void writeSummaryCsv(std::ostream& out, const std::string& prefix, const std::string& index,
+                         const LatencyHistogram& histogram) {
+        LatencySummary summary = LatencySummary::of(histogram);
+        out << prefix << "_count," << index << "," << summary.count << "\n"
+            << prefix << "_p50," << index << "," << summary.p50 << "\n"
+            << prefix << "_p90," << index << "," << summary.p90 << "\n"
+            << prefix << "_p99," << index << "," << summary.p99 << "\n"
+            << prefix << "_max," << index << "," << summary.max << "\n";
+    }
+
+    void writeUsageJson(std::ostream& out, const CarUsage& usage) {
+        out << "\"idle\": " << SimClock::toSimSeconds(usage.ticks(ElevatorState::IDLE))
+            << ", \"moving_up\": " << SimClock::toSimSeconds(usage.ticks(ElevatorState::MOVING_UP))
+            << ", \"moving_down\": " << SimClock::toSimSeconds(usage.ticks(ElevatorState::MOVING_DOWN))
+            << ", \"stopped\": " << SimClock::toSimSeconds(usage.ticks(ElevatorState::STOPPED))
+            << ", \"load_time\": " << SimClock::toSimSeconds(usage.loadTicks)
+            << ", \"floors\": " << usage.floors
+            << ", \"stops\": " << usage.stops
+            << ", \"door_cycles\": " << usage.doorCycles;
+    }
+
+    void writeUsageCsv(std::ostream& out, const std::string& index, const CarUsage& usage) {
+        out << "car_idle_time," << index << "," << SimClock::toSimSeconds(usage.ticks(ElevatorState::IDLE)) << "\n"
+            << "car_moving_up_time," << index << "," << SimClock::toSimSeconds(usage.ticks(ElevatorState::MOVING_UP)) << "\n"
+            << "car_moving_down_time," << index << "," << SimClock::toSimSeconds(usage.ticks(ElevatorState::MOVING_DOWN)) << "\n"
+            << "car_stopped_time," << index << "," << SimClock::toSimSeconds(usage.ticks(ElevatorState::STOPPED)) << "\n"
+            << "car_load_time," << index << "," << SimClock::toSimSeconds(usage.loadTicks) << "\n"
+            << "car_floors," << index << "," << usage.floors << "\n"
+            << "car_stops," << index << "," << usage.stops << "\n"
+            << "car_door_cycles," << index << "," << usage.doorCycles << "\n";
+    }
+
+    bool parseDouble(const std::string& text, double& value) {
+        std::istringstream iss(text);
+        iss >> value;
+        return !iss.fail() && iss.eof() && value > 0;
+    }
+
+    bool parseInt(const std::string& text, long long& value) {
+        std::istringstream iss(text);
+        iss >> value;
+        return !iss.fail() && iss.eof() && value >= 0;
+    }
+
+    bool isFlag(const std::string& key) {
+        return key == "random" || key == "quiet" || key == "memory-report" || key == "auto-strategy" ||
+               key == "self-check";
+    }
+}
+
+void BatchRunner::printUsage() {
+    std::cout << "用法：elevator_simulation [选项]\n"
+              << "不带参数时进入交互菜单；带参数时以批处理模式全速运行一天。\n\n"
+              << "  --scenario <文件>      从请求文件加载乘客请求\n"
+              << "  --random               随机生成请求\n"
+              << "  --seed <整数>          随机种子（配合 --random 可复现）\n"
+              << "  --peak <整数>          每个高峰时段的请求数（默认100）\n"
+              << "  --normal <整数>        平时请求数（默认50）\n"
+              << "  --elevators <整数>     电梯数（1-" << ElevatorConfig::MAX_ELEVATOR_COUNT << "，默认4）\n"
+              << "  --strategy <名称>      nearest | scan | look | destination | rollout\n"
+              << "  --auto-strategy        按识别出的客流模式自动切换策略（--strategy 为初始策略）\n"
+              << "  --traffic-window <数值> 客流模式识别的滑动窗口（模拟秒）\n"
+              << "  --parking <名称>       lobby（空闲回 1 层，默认）| forecast（按需求预测停靠）\n"
+              << "  --forecast-file <文件> 需求预测表：运行前读入（文件不存在则从头学习），运行后更新\n"
+              << "  --forecast-decay <数值> 每天并入需求预测表的权重（0-1，默认0.3）\n"
+              << "  --emergency-share <数值> 随机请求中紧急召唤的比例（0-1，默认0）\n"
+              << "  --accessibility-share <数值> 随机请求中无障碍召唤的比例（0-1，默认0）\n"
+              << "  --emergency-target <数值> 紧急召唤的候梯时限目标（模拟秒）\n"
+              << "  --accessibility-target <数值> 无障碍召唤的候梯时限目标（模拟秒）\n"
+              << "  --floor-time <数值>    每层运行时间（模拟秒）\n"
+              << "  --door-time <数值>     开关门停留时间（模拟秒）\n"
+              << "  --idle-time <数值>     空闲等待时间（模拟秒）\n"
+              << "  --max-wait <数值>      最大等待时间（模拟秒）\n"
+              << "  --day-time <数值>      模拟总时长（模拟秒）\n"
+              << "  --dispatch-window <数值> 目的层派梯的批处理窗口（模拟秒）\n"
+              << "  --rollout-horizon <数值> 前瞻模拟时长（模拟秒，默认一次往返全程）\n"
+              << "  --rollout-budget <数值>  每次前瞻派梯的墙钟预算（微秒，默认500）\n"
+              << "  --rollout-threads <整数> 前瞻模拟工作线程数（默认按处理器核数）\n"
+              << "  --kiosk-threads <整数> 运行时用多个线程并发查询乘梯预测，统计查询次数和耗时\n"
+              << "  --motion <名称>        constant（匀速，默认）| kinematic（运动学模型）\n"
+              << "  --floor-height <数值>  层高（米，运动学模型）\n"
+              << "  --rated-speed <数值>   额定速度（米/秒，运动学模型）\n"
+              << "  --acceleration <数值>  最大加速度（米/秒²，运动学模型）\n"
+              << "  --jerk <数值>          加加速度（米/秒³，运动学模型）\n"
+              << "  --door-dwell <数值>    开关门停留时间（真实秒，运动学模型）\n"
+              << "  --config <文件>        从配置文件读取以上参数（每行 键=值）\n"
+              << "  --metrics-file <文件>  运行时定期把仿真指标写成 OpenMetrics 文本文件\n"
+              << "  --metrics-interval <数值> 指标文件的写入间隔（墙钟秒，默认1）\n"
+              << "  --shm-name <名称>     运行时把电梯和候梯状态发布到该名称的 POSIX 共享内存段\n"
+              << "  --shm-dump <名称>     读取另一个仿真发布的共享内存状态段，打印一次后退出\n"
+              << "  --json <文件>          将统计结果写为 JSON\n"
+              << "  --csv <文件>           将统计结果写为 CSV\n"
+              << "  --quiet                不在终端打印统计信息\n"
+              << "  --memory-report        打印乘客记录和电梯的内存占用\n"
+              << "  --self-check           用随机电梯组比较各派梯内核与标量版本的选梯结果后退出\n"
+              << "  --help                 显示本帮助\n";
+}
+
+bool BatchRunner::applyOption(const std::string& key, const std::string& value) {
+    double number = 0.0;
+    long long integer = 0;
+
+    if (key == "scenario") {
+        options.scenarioFile = value;
+    } else if (key == "random") {
+        options.randomRequests = true;
+    } else if (key == "quiet") {
+        options.quiet = true;
+    } else if (key == "memory-report") {
+        options.memoryReport = true;
+    } else if (key == "self-check") {
+        options.selfCheck = true;
+    } else if (key == "auto-strategy") {
+        ElevatorConfig::setAutoStrategy(true);
+    } else if (key == "traffic-window") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setTrafficWindow(number);
+    } else if (key == "seed") {
+        if (!parseInt(value, integer)) return false;
+        options.seed = static_cast<unsigned>(integer);
+        options.hasSeed = true;
+    } else if (key == "peak") {
+        if (!parseInt(value, integer) || integer == 0) return false;
+        options.peakRequests = static_cast<int>(integer);
+    } else if (key == "normal") {
+        if (!parseInt(value, integer) || integer == 0) return false;
+        options.normalRequests = static_cast<int>(integer);
+    } else if (key == "elevators") {
+        if (!parseInt(value, integer) || integer < 1 || integer > ElevatorConfig::MAX_ELEVATOR_COUNT) return false;
+        ElevatorConfig::setElevatorCount(static_cast<int>(integer));
+    } else if (key == "strategy") {
+        return parseStrategy(value, options.strategy);
+    } else if (key == "floor-time") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setFloorTime(number);
+    } else if (key == "door-time") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setDoorTime(number);
+    } else if (key == "idle-time") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setIdleMaxTime(number);
+    } else if (key == "max-wait") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setMaxWaitTime(number);
+    } else if (key == "day-time") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setDaySimulationTime(number);
+    } else if (key == "dispatch-window") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setDispatchWindow(number);
+    } else if (key == "rollout-horizon") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setRolloutHorizon(number);
+    } else if (key == "rollout-budget") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setRolloutBudget(number);
+    } else if (key == "rollout-threads") {
+        if (!parseInt(value, integer)) return false;
+        ElevatorConfig::setRolloutThreads(static_cast<int>(integer));
+    } else if (key == "kiosk-threads") {
+        if (!parseInt(value, integer)) return false;
+        options.kioskThreads = static_cast<int>(integer);
+    } else if (key == "emergency-share") {
+        if (!parseDouble(value, number) || number + ElevatorConfig::ACCESSIBILITY_SHARE > 1) return false;
+        ElevatorConfig::setPriorityShares(number, ElevatorConfig::ACCESSIBILITY_SHARE);
+    } else if (key == "accessibility-share") {
+        if (!parseDouble(value, number) || number + ElevatorConfig::EMERGENCY_SHARE > 1) return false;
+        ElevatorConfig::setPriorityShares(ElevatorConfig::EMERGENCY_SHARE, number);
+    } else if (key == "emergency-target") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setEmergencyWaitTarget(number);
+    } else if (key == "accessibility-target") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setAccessibilityWaitTarget(number);
+    } else if (key == "parking") {
+        if (value != "lobby" && value != "forecast") return false;
+        ElevatorConfig::setForecastParking(value == "forecast");
+    } else if (key == "forecast-file") {
+        options.forecastFile = value;
+    } else if (key == "forecast-decay") {
+        if (!parseDouble(value, number) || number <= 0 || number > 1) return false;
+        ElevatorConfig::setForecastDecay(number);
+    } else if (key == "motion") {
+        if (value != "constant" && value != "kinematic") return false;
+        ElevatorConfig::setKinematicMotion(value == "kinematic");
+    } else if (key == "floor-height") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setFloorHeight(number);
+    } else if (key == "rated-speed") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setRatedSpeed(number);
+    } else if (key == "acceleration") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setAcceleration(number);
+    } else if (key == "jerk") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setJerk(number);
+    } else if (key == "door-dwell") {
+        if (!parseDouble(value, number)) return false;
+        ElevatorConfig::setDoorDwell(number);
+    } else if (key == "metrics-file") {
+        options.metricsFile = value;
+    } else if (key == "metrics-interval") {
+        if (!parseDouble(value, number)) return false;
+        options.metricsInterval = number;
+    } else if (key == "shm-name") {
+        options.liveStateName = value;
+    } else if (key == "shm-dump") {
+        options.liveStateDump = value;
+    } else if (key == "json") {
+        options.jsonOutput = value;
+    } else if (key == "csv") {
+        options.csvOutput = value;
+    } else if (key == "config") {
+        return loadConfigFile(value);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool BatchRunner::loadConfigFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "无法打开配置文件: " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::string::size_type pos = line.find('=');
+        std::string key = line.substr(0, pos);
+        std::string value = pos == std::string::npos ? "" : line.substr(pos + 1);
+        key.erase(0, key.find_first_not_of(" \t"));
+        key.erase(key.find_last_not_of(" \t") + 1);
+        value.erase(0, value.find_first_not_of(" \t"));
+        value.erase(value.find_last_not_of(" \t") + 1);
+        if (key.empty()) continue;
+
+        if (!applyOption(key, value)) {
+            std::cerr << "无效的配置项: " << line << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BatchRunner::parseArguments(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            options.helpRequested = true;
+            return true;
+        }
+        if (arg.compare(0, 2, "--") != 0) {
+            std::cerr << "无法识别的参数: " << arg << std::endl;
+            return false;
+        }
+
+        std::string key = arg.substr(2);
+        std::string value;
+        if (!isFlag(key)) {
+            if (i + 1 >= argc) {
+                std::cerr << "参数缺少取值: " << arg << std::endl;
+                return false;
+            }
+            value = argv[++i];
+        }
+
+        if (!applyOption(key, value)) {
+            std::cerr << "无效的参数: " << arg << " " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (options.scenarioFile.empty() && !options.randomRequests && !options.selfCheck &&
+        options.liveStateDump.empty()) {
+        std::cerr << "需要指定 --scenario 或 --random" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int BatchRunner::run() {
+    if (options.helpRequested) {
+        printUsage();
+        return 0;
+    }
+    if (options.selfCheck) {
+        return runSelfCheck();
+    }
+    if (!options.liveStateDump.empty()) {
+        return runLiveStateDump();
+    }
+
+    system.start();
+    system.setStrategy(options.strategy);
+
+    if (!options.scenarioFile.empty() && !system.loadFileRequests(options.scenarioFile)) {
+        return 2;
+    }
+    if (options.randomRequests) {
+        system.setRequestCounts(options.peakRequests, options.normalRequests);
+        if (options.hasSeed) {
+            system.loadRandomRequests(options.seed);
+        } else {
+            system.loadRandomRequests();
+        }
+    }
+
+    if (!options.forecastFile.empty() && std::filesystem::exists(options.forecastFile) &&
+        !system.loadForecast(options.forecastFile)) {
+        return 2;
+    }
+
+    if (!options.metricsFile.empty()) {
+        system.enableMetricsExport(options.metricsFile, options.metricsInterval);
+    }
+
+    if (!options.liveStateName.empty() && !system.enableLiveState(options.liveStateName)) {
+        std::cerr << "无法创建共享内存状态段: " << options.liveStateName << std::endl;
+        return 2;
+    }
+
+    double wallSeconds = 0.0;
+    if (options.kioskThreads > 0) {
+        runKioskQueries(wallSeconds);
+    } else {
+        auto wallStart = std::chrono::steady_clock::now();
+        system.runUntil(ElevatorConfig::DAY_SIMULATION_TIME);
+        wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    }
+
+    bool ok = true;
+    if (!options.metricsFile.empty() && !system.disableMetricsExport()) {
+        std::cerr << "无法写入指标文件: " << options.metricsFile << std::endl;
+        ok = false;
+    }
+
+    SimulationStats stats = system.getStatistics();
+    Logger::log("批处理模拟完成，耗时 " + std::to_string(wallSeconds) + " 秒");
+
+    if (!options.quiet) {
+        system.printStatistics();
+        std::cout << "\n运行耗时：" << std::fixed << std::setprecision(3) << wallSeconds << " 秒\n";
+        if (options.kioskThreads > 0) {
+            std::cout << "乘梯预测查询：" << options.kioskThreads << " 个线程共 " << kioskQueries
+                      << " 次，平均 " << kioskQueryMicros << " 微秒\n";
+        }
+    }
+    if (options.memoryReport) {
+        system.printMemoryFootprint();
+    }
+
+    if (!options.forecastFile.empty()) ok = system.saveForecast(options.forecastFile) && ok;
+    if (!options.jsonOutput.empty()) ok = writeJson(stats, wallSeconds) && ok;
+    if (!options.csvOutput.empty()) ok = writeCsv(stats, wallSeconds) && ok;
+    return ok ? 0 : 3;
+}
+
+int BatchRunner::runSelfCheck() const {
+    constexpr int ROUNDS = 20;
+    const int maxCars = ElevatorConfig::MAX_ELEVATOR_COUNT;
+    const std::string kernels = ElevatorFleet::hasAvx2() ? "AVX2 内核、楼层索引搜索" : "楼层索引搜索";
+
+    unsigned seed = options.hasSeed ? options.seed : std::random_device{}();
+    long long mismatches = ElevatorFleet::selfCheck(maxCars, ROUNDS, seed);
+    std::cout << "派梯内核自检（1-" << maxCars << " 部电梯，种子 " << seed << "）：" << kernels
+              << (mismatches == 0 ? "与标量版本结果一致" :
+                  "与标量版本共有 " + std::to_string(mismatches) + " 次不一致") << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
+
+int BatchRunner::runLiveStateDump() const {
+    LiveStateSegment segment;
+    if (!segment.attach(options.liveStateDump)) {
+        std::cerr << "无法打开共享内存状态段: " << options.liveStateDump
+                  << "（段不存在，或不是本程序以相同楼层数和电梯数上限创建的）" << std::endl;
+        return 2;
+    }
+    LiveStateData state;
+    if (!segment.read(state)) {
+        std::cerr << "共享内存状态段一直在改写，未能读到一致的状态" << std::endl;
+        return 2;
+    }
+
+    uint32_t cars = std::min<uint32_t>(state.carCount, ElevatorConfig::MAX_ELEVATOR_COUNT);
+    std::cout << "模拟时刻：" << SimClock::formatClock(state.simTicks) << "\n";
+    for (uint32_t i = 0; i < cars; ++i) {
+        const LiveStateData::Car& car = state.cars[i];
+        std::cout << "电梯 " << (i + 1) << "：" << static_cast<int>(car.floor) << " 层，"
+                  << stateName(static_cast<ElevatorState>(car.state)) << "，载客 "
+                  << static_cast<int>(car.load) << " 人\n";
+    }
+    std::cout << "候梯人数（上行 / 下行）：\n";
+    for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
+        std::cout << "第 " << std::setw(2) << floor << " 层：" << state.upQueue[floor - 1]
+                  << " / " << state.downQueue[floor - 1] << "\n";
+    }
+    return 0;
+}
+
+void BatchRunner::runKioskQueries(double& wallSeconds) {
+    // 模拟大堂终端：查询线程随机取出发层和目的层，在仿真运行的同时不停查询
+    system.enableJourneyPrediction(true);
+    std::atomic<bool> done{false};
+    std::vector<long long> counts(options.kioskThreads, 0);
+    std::vector<double> seconds(options.kioskThreads, 0.0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < options.kioskThreads; ++t) {
+        readers.emplace_back([this, t, &done, &counts, &seconds]() {
+            std::mt19937 gen(static_cast<unsigned>(t) + 1);
+            std::uniform_int_distribution<> floorDist(1, ElevatorConfig::FLOOR_COUNT);
+            auto start = std::chrono::steady_clock::now();
+            long long queries = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                int from = floorDist(gen);
+                int to = floorDist(gen);
+                if (from == to) continue;
+                system.predict(from, to, 0.0);
+                ++queries;
+            }
+            counts[t] = queries;
+            seconds[t] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        });
+    }
+
+    auto wallStart = std::chrono::steady_clock::now();
+    system.runUntil(ElevatorConfig::DAY_SIMULATION_TIME);
+    wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    kioskQueries = 0;
+    double totalSeconds = 0.0;
+    for (int t = 0; t < options.kioskThreads; ++t) {
+        kioskQueries += counts[t];
+        totalSeconds += seconds[t];
+    }
+    kioskQueryMicros = kioskQueries > 0 ? totalSeconds * 1e6 / kioskQueries : 0.0;
+}
+
+bool BatchRunner::writeJson(const SimulationStats& stats, double wallSeconds) const {
+    std::ofstream out(options.jsonOutput);
+    if (!out.is_open()) {
+        std::cerr << "无法写入结果文件: " << options.jsonOutput << std::endl;
+        return false;
+    }
+
+    out << std::setprecision(10);
+    out << "{\n"
+        << "  \"strategy\": \"" << strategyKey(options.strategy) << "\",\n"
+        << "  \"auto_strategy\": " << (ElevatorConfig::AUTO_STRATEGY ? "true" : "false") << ",\n"
+        << "  \"parking\": \"" << (ElevatorConfig::FORECAST_PARKING ? "forecast" : "lobby") << "\",\n"
+        << "  \"motion\": \"" << (ElevatorConfig::KINEMATIC_MOTION ? "kinematic" : "constant") << "\",\n"
+        << "  \"floor_time\": " << ElevatorConfig::FLOOR_TIME << ",\n"
+        << "  \"door_time\": " << ElevatorConfig::DOOR_TIME << ",\n"
+        << "  \"idle_time\": " << ElevatorConfig::IDLE_MAX_TIME << ",\n"
+        << "  \"max_wait\": " << ElevatorConfig::MAX_WAIT_TIME << ",\n"
+        << "  \"simulated_time\": " << stats.simulatedTime << ",\n"
+        << "  \"wall_seconds\": " << wallSeconds << ",\n"
+        << "  \"total_requests\": " << stats.totalRequests << ",\n"
+        << "  \"timeout_requests\": " << stats.timeoutRequests << ",\n"
+        << "  \"total_wait_time\": " << stats.totalWaitTime << ",\n"
+        << "  \"strategy_switches\": " << stats.strategySwitches << ",\n";
+    if (options.kioskThreads > 0) {
+        out << "  \"kiosk_threads\": " << options.kioskThreads << ",\n"
+            << "  \"kiosk_queries\": " << kioskQueries << ",\n"
+            << "  \"kiosk_query_us\": " << kioskQueryMicros << ",\n";
+    }
+
+    out << "  \"floor_requests\": [";
+    for (size_t i = 0; i < stats.floorRequests.size(); ++i) {
+        out << (i ? ", " : "") << stats.floorRequests[i];
+    }
+    out << "],\n  \"hourly_requests\": [";
+    for (size_t i = 0; i < stats.hourlyRequests.size(); ++i) {
+        out << (i ? ", " : "") << stats.hourlyRequests[i];
+    }
+    out << "],\n  \"hourly_rate_percent\": [";
+    for (size_t i = 0; i < stats.hourlyRequests.size(); ++i) {
+        out << (i ? ", " : "") << stats.hourlyRate(static_cast<int>(i));
+    }
+    out << "],\n  \"priority_classes\": [";
+    for (int c = 0; c < PRIORITY_CLASS_COUNT; ++c) {
+        LatencySummary waits = LatencySummary::of(stats.classWaits[c]);
+        out << (c ? ",\n    " : "\n    ")
+            << "{\"class\": \"" << priorityKey(static_cast<PriorityClass>(c)) << "\", "
+            << "\"boarded\": " << waits.count << ", "
+            << "\"timeouts\": " << stats.classTimeouts[c] << ", "
+            << "\"within_target\": " << stats.classWithinTarget[c] << ", "
+            << "\"wait_p50\": " << waits.p50 << ", "
+            << "\"wait_p90\": " << waits.p90 << ", "
+            << "\"wait_p99\": " << waits.p99 << ", "
+            << "\"wait_max\": " << waits.max << "}";
+    }
+
+    // 时间均为模拟秒；各层按出发层和方向、各时段按请求时刻分组
+    const JourneyLatency& journeys = stats.journeys;
+    out << "\n  ],\n  \"latency\": {";
+    for (int m = 0; m < JourneyLatency::METRIC_COUNT; ++m) {
+        auto metric = static_cast<JourneyLatency::Metric>(m);
+        out << (m ? ",\n    " : "\n    ") << "\"" << metricKey(metric) << "\": ";
+        writeSummaryJson(out, journeys.overall(metric));
+    }
+    out << "\n  },\n  \"latency_by_floor\": [";
+    bool first = true;
+    for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
+        for (bool up : {true, false}) {
+            out << (first ? "\n    " : ",\n    ") << "{\"floor\": " << floor
+                << ", \"direction\": \"" << (up ? "up" : "down") << "\"";
+            first = false;
+            for (int m = 0; m < JourneyLatency::METRIC_COUNT; ++m) {
+                auto metric = static_cast<JourneyLatency::Metric>(m);
+                out << ", \"" << metricKey(metric) << "\": ";
+                writeSummaryJson(out, journeys.byFloor(metric, floor, up));
+            }
+            out << "}";
+        }
+    }
+    out << "\n  ],\n  \"latency_by_hour\": [";
+    for (int hour = 0; hour < JourneyLatency::HOURS; ++hour) {
+        out << (hour ? ",\n    " : "\n    ") << "{\"hour\": " << hour;
+        for (int m = 0; m < JourneyLatency::METRIC_COUNT; ++m) {
+            auto metric = static_cast<JourneyLatency::Metric>(m);
+            out << ", \"" << metricKey(metric) << "\": ";
+            writeSummaryJson(out, journeys.byHour(metric, hour));
+        }
+        out << "}";
+    }
+
+    // 各电梯全天及每小时的使用统计：各状态时间、载客人数对时间的积分（模拟秒）和计数
+    out << "\n  ],\n  \"car_usage\": [";
+    const int cars = static_cast<int>(stats.carUsage.size()) / UtilizationTracker::HOURS;
+    for (int car = 0; car < cars; ++car) {
+        CarUsage day;
+        for (int hour = 0; hour < UtilizationTracker::HOURS; ++hour) {
+            day.merge(stats.carUsage[car * UtilizationTracker::HOURS + hour]);
+        }
+        out << (car ? ",\n    " : "\n    ") << "{\"car\": " << (car + 1) << ", ";
+        writeUsageJson(out, day);
+        out << ", \"hours\": [";
+        for (int hour = 0; hour < UtilizationTracker::HOURS; ++hour) {
+            out << (hour ? ",\n      " : "\n      ") << "{\"hour\": " << hour << ", ";
+            writeUsageJson(out, stats.carUsage[car * UtilizationTracker::HOURS + hour]);
+            out << "}";
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+    return true;
+}
+
+bool BatchRunner::writeCsv(const SimulationStats& stats, double wallSeconds) const {
+    std::ofstream out(options.csvOutput);
+    if (!out.is_open()) {
+        std::cerr << "无法写入结果文件: " << options.csvOutput << std::endl;
+        return false;
+    }
+
+    out << std::setprecision(10);
+    out << "metric,index,value\n"
+        << "strategy,," << strategyKey(options.strategy) << "\n"
+        << "simulated_time,," << stats.simulatedTime << "\n"
+        << "wall_seconds,," << wallSeconds << "\n"
+        << "total_requests,," << stats.totalRequests << "\n"
+        << "timeout_requests,," << stats.timeoutRequests << "\n"
+        << "total_wait_time,," << stats.totalWaitTime << "\n"
+        << "strategy_switches,," << stats.strategySwitches << "\n";
+    for (size_t i = 0; i < stats.floorRequests.size(); ++i) {
+        out << "floor_requests," << (i + 1) << "," << stats.floorRequests[i] << "\n";
+    }
+    for (size_t i = 0; i < stats.hourlyRequests.size(); ++i) {
+        out << "hourly_requests," << i << "," << stats.hourlyRequests[i] << "\n";
+    }
+    for (int c = 0; c < PRIORITY_CLASS_COUNT; ++c) {
+        LatencySummary waits = LatencySummary::of(stats.classWaits[c]);
+        const char* key = priorityKey(static_cast<PriorityClass>(c));
+        out << "class_boarded," << key << "," << waits.count << "\n"
+            << "class_timeouts," << key << "," << stats.classTimeouts[c] << "\n"
+            << "class_within_target," << key << "," << stats.classWithinTarget[c] << "\n"
+            << "class_wait_p50," << key << "," << waits.p50 << "\n"
+            << "class_wait_p90," << key << "," << waits.p90 << "\n"
+            << "class_wait_p99," << key << "," << waits.p99 << "\n"
+            << "class_wait_max," << key << "," << waits.max << "\n";
+    }
+
+    const JourneyLatency& journeys = stats.journeys;
+    for (int m = 0; m < JourneyLatency::METRIC_COUNT; ++m) {
+        auto metric = static_cast<JourneyLatency::Metric>(m);
+        writeSummaryCsv(out, metricKey(metric), "", journeys.overall(metric));
+    }
+    for (int m = 0; m < JourneyLatency::METRIC_COUNT; ++m) {
+        auto metric = static_cast<JourneyLatency::Metric>(m);
+        std::string prefix = std::string(metricKey(metric)) + "_by_floor";
+        for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
+            for (bool up : {true, false}) {
+                writeSummaryCsv(out, prefix, std::to_string(floor) + (up ? "up" : "down"),
+                                journeys.byFloor(metric, floor, up));
+            }
+        }
+    }
+    for (int m = 0; m < JourneyLatency::METRIC_COUNT; ++m) {
+        auto metric = static_cast<JourneyLatency::Metric>(m);
+        std::string prefix = std::string(metricKey(metric)) + "_by_hour";
+        for (int hour = 0; hour < JourneyLatency::HOURS; ++hour) {
+            writeSummaryCsv(out, prefix, std::to_string(hour), journeys.byHour(metric, hour));
+        }
+    }
+
+    // 电梯的全天统计以电梯号为下标，每小时的以“电梯号-小时”为下标
+    const int cars = static_cast<int>(stats.carUsage.size()) / UtilizationTracker::HOURS;
+    for (int car = 0; car < cars; ++car) {
+        CarUsage day;
+        for (int hour = 0; hour < UtilizationTracker::HOURS; ++hour) {
+            day.merge(stats.carUsage[car * UtilizationTracker::HOURS + hour]);
+        }
+        writeUsageCsv(out, std::to_string(car + 1), day);
+    }
+    for (int car = 0; car < cars; ++car) {
+        for (int hour = 0; hour < UtilizationTracker::HOURS; ++hour) {
+            writeUsageCsv(out, std::to_string(car + 1) + "-" + std::to_string(hour),
+                          stats.carUsage[car * UtilizationTracker::HOURS + hour]);
+        }
+    }
+    return true;
+}
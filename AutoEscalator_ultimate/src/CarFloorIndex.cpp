@@ -0,0 +1,69 @@
+#include "CarFloorIndex.h"
+
+void CarFloorIndex::resize(int cars) {
+    words = (cars + 63) / 64;
+    for (auto& bits : carBits) {
+        bits.assign(static_cast<size_t>(ElevatorConfig::FLOOR_COUNT) * words, 0);
+    }
+    for (auto& perFloor : counts) {
+        perFloor.fill(0);
+    }
+    floorMasks.fill(0);
+    targetCounts.fill(0);
+    targetMask = 0;
+    // 新电梯都记为停在 1 层的空闲电梯
+    carFloor.assign(cars, 1);
+    carTarget.assign(cars, -1);
+    carCategory.assign(cars, IDLE);
+    for (int car = 0; car < cars; ++car) {
+        insert(car, 1, IDLE);
+    }
+}
+
+void CarFloorIndex::insert(int car, int floor, int category) {
+    carBits[category][static_cast<size_t>(floor - 1) * words + car / 64] |= uint64_t(1) << (car % 64);
+    if (counts[category][floor - 1]++ == 0) {
+        floorMasks[category] |= BitOps::floorBit(floor);
+    }
+}
+
+void CarFloorIndex::erase(int car, int floor, int category) {
+    carBits[category][static_cast<size_t>(floor - 1) * words + car / 64] &= ~(uint64_t(1) << (car % 64));
+    if (--counts[category][floor - 1] == 0) {
+        floorMasks[category] &= ~BitOps::floorBit(floor);
+    }
+}
+
+void CarFloorIndex::update(int car, int floor, Category category, int targetFloor) {
+    if (floor != carFloor[car] || category != carCategory[car]) {
+        erase(car, carFloor[car], carCategory[car]);
+        insert(car, floor, category);
+        carFloor[car] = static_cast<int8_t>(floor);
+        carCategory[car] = category;
+    }
+
+    if (targetFloor != carTarget[car]) {
+        if (carTarget[car] > 0 && --targetCounts[carTarget[car] - 1] == 0) {
+            targetMask &= ~BitOps::floorBit(carTarget[car]);
+        }
+        if (targetFloor > 0 && targetCounts[targetFloor - 1]++ == 0) {
+            targetMask |= BitOps::floorBit(targetFloor);
+        }
+        carTarget[car] = static_cast<int8_t>(targetFloor);
+    }
+}
+
+int CarFloorIndex::nextPassing(int floor, bool up) const {
+    // 上行电梯找 floor 层及以下最近的一部，下行电梯找 floor 层及以上最近的一部
+    uint32_t bit = BitOps::floorBit(floor);
+    uint32_t mask = up ? floorMasks[MOVING_UP] & (BitOps::maskBelow(floor) | bit)
+                       : floorMasks[MOVING_DOWN] & (BitOps::maskAbove(floor) | bit);
+    if (mask == 0) return -1;
+
+    int passing = up ? BitOps::highestFloor(mask) : BitOps::lowestFloor(mask);
+    int car = -1;
+    forEachCar(up ? MOVING_UP : MOVING_DOWN, passing, [&](int index) {
+        if (car < 0) car = index;
+    });
+    return car;
+}
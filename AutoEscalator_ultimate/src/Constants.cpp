@@ -1,32 +1,162 @@
-#include "Constants.h"
-
-namespace ElevatorConfig {
-    double FLOOR_TIME = 5.0;
-    double IDLE_MAX_TIME = 10.0;
-    double MAX_WAIT_TIME = 60.0;
-    double DAY_SIMULATION_TIME = 24.0;
-
-    void setFloorTime(double time) {
-        if (time > 0) {
-            FLOOR_TIME = time;
-        }
-    }
-
-    void setIdleMaxTime(double time) {
-        if (time > 0) {
-            IDLE_MAX_TIME = time;
-        }
-    }
-
-    void setMaxWaitTime(double time) {
-        if (time > 0) {
-            MAX_WAIT_TIME = time;
-        }
-    }
-
-    void setDaySimulationTime(double time) {
-        if (time > 0) {
-            DAY_SIMULATION_TIME = time;
-        }
-    }
+#include "Constants.h"
+
+namespace ElevatorConfig {
+    int ELEVATOR_COUNT = 4;
+    double FLOOR_TIME = 5.0;
+    double DOOR_TIME = 1.0;
+    double IDLE_MAX_TIME = 10.0;
+    double MAX_WAIT_TIME = 60.0;
+    double DAY_SIMULATION_TIME = 24.0;
+    double DISPATCH_WINDOW = 3.0 / REAL_SECONDS_PER_SIM_SECOND;
+    double ROLLOUT_HORIZON = 0.0;
+    double ROLLOUT_BUDGET = 500.0;
+    int ROLLOUT_THREADS = -1;
+    bool AUTO_STRATEGY = false;
+    double TRAFFIC_WINDOW = 300.0 / REAL_SECONDS_PER_SIM_SECOND;
+    bool FORECAST_PARKING = false;
+    double FORECAST_DECAY = 0.3;
+    double EMERGENCY_WAIT_TARGET = 30.0 / REAL_SECONDS_PER_SIM_SECOND;
+    double ACCESSIBILITY_WAIT_TARGET = 60.0 / REAL_SECONDS_PER_SIM_SECOND;
+    double EMERGENCY_SHARE = 0.0;
+    double ACCESSIBILITY_SHARE = 0.0;
+
+    bool KINEMATIC_MOTION = false;
+    double FLOOR_HEIGHT = 3.5;
+    double RATED_SPEED = 2.5;
+    double ACCELERATION = 1.0;
+    double JERK = 1.5;
+    double DOOR_DWELL = 6.0;
+
+    void setElevatorCount(int count) {
+        if (count >= 1 && count <= MAX_ELEVATOR_COUNT) {
+            ELEVATOR_COUNT = count;
+        }
+    }
+
+    void setFloorTime(double time) {
+        if (time > 0) {
+            FLOOR_TIME = time;
+        }
+    }
+
+    void setDoorTime(double time) {
+        if (time > 0) {
+            DOOR_TIME = time;
+        }
+    }
+
+    void setIdleMaxTime(double time) {
+        if (time > 0) {
+            IDLE_MAX_TIME = time;
+        }
+    }
+
+    void setMaxWaitTime(double time) {
+        if (time > 0) {
+            MAX_WAIT_TIME = time;
+        }
+    }
+
+    void setDaySimulationTime(double time) {
+        if (time > 0) {
+            DAY_SIMULATION_TIME = time;
+        }
+    }
+
+    void setDispatchWindow(double time) {
+        if (time > 0) {
+            DISPATCH_WINDOW = time;
+        }
+    }
+
+    void setRolloutHorizon(double time) {
+        if (time >= 0) {
+            ROLLOUT_HORIZON = time;
+        }
+    }
+
+    void setRolloutBudget(double microseconds) {
+        if (microseconds > 0) {
+            ROLLOUT_BUDGET = microseconds;
+        }
+    }
+
+    void setRolloutThreads(int threads) {
+        if (threads >= -1) {
+            ROLLOUT_THREADS = threads;
+        }
+    }
+
+    void setAutoStrategy(bool enabled) {
+        AUTO_STRATEGY = enabled;
+    }
+
+    void setTrafficWindow(double time) {
+        if (time > 0) {
+            TRAFFIC_WINDOW = time;
+        }
+    }
+
+    void setForecastParking(bool enabled) {
+        FORECAST_PARKING = enabled;
+    }
+
+    void setForecastDecay(double weight) {
+        if (weight > 0 && weight <= 1) {
+            FORECAST_DECAY = weight;
+        }
+    }
+
+    void setEmergencyWaitTarget(double time) {
+        if (time > 0) {
+            EMERGENCY_WAIT_TARGET = time;
+        }
+    }
+
+    void setAccessibilityWaitTarget(double time) {
+        if (time > 0) {
+            ACCESSIBILITY_WAIT_TARGET = time;
+        }
+    }
+
+    void setPriorityShares(double emergency, double accessibility) {
+        if (emergency >= 0 && accessibility >= 0 && emergency + accessibility <= 1) {
+            EMERGENCY_SHARE = emergency;
+            ACCESSIBILITY_SHARE = accessibility;
+        }
+    }
+
+    void setKinematicMotion(bool enabled) {
+        KINEMATIC_MOTION = enabled;
+    }
+
+    void setFloorHeight(double meters) {
+        if (meters > 0) {
+            FLOOR_HEIGHT = meters;
+        }
+    }
+
+    void setRatedSpeed(double speed) {
+        if (speed > 0) {
+            RATED_SPEED = speed;
+        }
+    }
+
+    void setAcceleration(double acceleration) {
+        if (acceleration > 0) {
+            ACCELERATION = acceleration;
+        }
+    }
+
+    void setJerk(double jerk) {
+        if (jerk > 0) {
+            JERK = jerk;
+        }
+    }
+
+    void setDoorDwell(double seconds) {
+        if (seconds > 0) {
+            DOOR_DWELL = seconds;
+        }
+    }
 } 
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "DeadlineIndex.h"
+
+void DeadlineIndex::add(PassengerHandle handle) {
+    const Passenger& passenger = pool[handle];
+    heap.push(Entry{passenger.deadline(), handle, passenger.serial,
+                    passenger.sourceFloor, passenger.targetFloor > passenger.sourceFloor});
+}
+
+void DeadlineIndex::discardStale() {
+    while (!heap.empty()) {
+        const Entry& top = heap.top();
+        const Passenger& passenger = pool[top.handle];
+        if (passenger.serial == top.serial && passenger.status == PassengerStatus::WAITING) {
+            return;
+        }
+        heap.pop();
+    }
+}
+
+bool DeadlineIndex::empty() {
+    discardStale();
+    return heap.empty();
+}
+
+SimTime DeadlineIndex::nextDeadline() {
+    discardStale();
+    return heap.top().deadline;
+}
+
+DeadlineIndex::Entry DeadlineIndex::pop() {
+    discardStale();
+    Entry entry = heap.top();
+    heap.pop();
+    return entry;
+}
+
+void DeadlineIndex::clear() {
+    heap = decltype(heap)();
+}
@@ -0,0 +1,126 @@
+#include "DemandForecast.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr SimTime DAY_TICKS = DemandForecast::SLOTS_PER_DAY * DemandForecast::SLOT_TICKS;
+}
+
+DemandForecast::DemandForecast()
+    : history(SLOTS_PER_DAY, FloorDemand{}), today(SLOTS_PER_DAY, FloorDemand{}) {
+}
+
+int DemandForecast::slotOf(SimTime time) {
+    SimTime inDay = time % DAY_TICKS;
+    if (inDay < 0) inDay += DAY_TICKS;
+    return static_cast<int>(inDay / SLOT_TICKS);
+}
+
+void DemandForecast::reset() {
+    std::fill(today.begin(), today.end(), FloorDemand{});
+    recent.fill(0.0);
+    recentTime = 0;
+}
+
+void DemandForecast::record(SimTime time, int floor, int count) {
+    today[slotOf(time)][floor - 1] += count;
+
+    if (time > recentTime) {
+        double decay = std::exp(-static_cast<double>(time - recentTime) / SLOT_TICKS);
+        for (double& value : recent) {
+            value *= decay;
+        }
+        recentTime = time;
+    }
+    recent[floor - 1] += count;
+}
+
+DemandForecast::FloorDemand DemandForecast::demand(SimTime time) const {
+    FloorDemand result{};
+    double decay = time > recentTime ? std::exp(-static_cast<double>(time - recentTime) / SLOT_TICKS) : 1.0;
+    for (int i = 0; i < ElevatorConfig::FLOOR_COUNT; ++i) {
+        result[i] = recent[i] * decay;
+    }
+    if (!hasHistory) return result;
+
+    // 接下来一个时段跨越当前时段的剩余部分和下一个时段的开头，按时长加权
+    int slot = slotOf(time);
+    int next = (slot + 1) % SLOTS_PER_DAY;
+    double elapsed = static_cast<double>(((time % SLOT_TICKS) + SLOT_TICKS) % SLOT_TICKS) / SLOT_TICKS;
+    for (int i = 0; i < ElevatorConfig::FLOOR_COUNT; ++i) {
+        double expected = history[slot][i] * (1.0 - elapsed) + history[next][i] * elapsed;
+        result[i] = (result[i] + expected) / 2;
+    }
+    return result;
+}
+
+void DemandForecast::finishDay(SimTime endTime, double weight) {
+    // 只并入完整跑过的时段，没跑到的时段保留原有的历史数据
+    int slots = endTime >= DAY_TICKS ? SLOTS_PER_DAY : static_cast<int>(endTime / SLOT_TICKS);
+    for (int slot = 0; slot < slots; ++slot) {
+        for (int i = 0; i < ElevatorConfig::FLOOR_COUNT; ++i) {
+            history[slot][i] = hasHistory ? history[slot][i] * (1.0 - weight) + today[slot][i] * weight
+                                          : today[slot][i];
+        }
+    }
+    if (slots > 0) {
+        hasHistory = true;
+    }
+}
+
+bool DemandForecast::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "无法打开需求预测文件: " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        int hour, minute;
+        char colon;
+        FloorDemand values{};
+        std::istringstream iss(line);
+        iss >> hour >> colon >> minute;
+        for (double& value : values) {
+            iss >> value;
+        }
+
+        int slot = (hour * 60 + minute) * 60 * static_cast<int>(SimClock::TICKS_PER_REAL_SECOND) / SLOT_TICKS;
+        if (iss.fail() || colon != ':' || slot < 0 || slot >= SLOTS_PER_DAY) {
+            std::cerr << "无效的需求预测行: " << line << std::endl;
+            continue;
+        }
+        history[slot] = values;
+        hasHistory = true;
+    }
+    return true;
+}
+
+bool DemandForecast::save(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "无法写入需求预测文件: " << filename << std::endl;
+        return false;
+    }
+
+    file << "# 时段起点 1层到" << ElevatorConfig::FLOOR_COUNT << "层每时段平均召唤人数\n";
+    file << std::setprecision(6);
+    for (int slot = 0; slot < SLOTS_PER_DAY; ++slot) {
+        int minutes = static_cast<int>(slot * SLOT_TICKS / SimClock::TICKS_PER_REAL_SECOND / 60);
+        file << std::setw(2) << std::setfill('0') << minutes / 60 << ':'
+             << std::setw(2) << minutes % 60 << std::setfill(' ');
+        for (double value : history[slot]) {
+            file << ' ' << value;
+        }
+        file << '\n';
+    }
+    return true;
+}
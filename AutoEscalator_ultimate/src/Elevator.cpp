@@ -1,99 +1,122 @@
-#include "Elevator.h"
-#include "Constants.h"
-#include <algorithm>
-
-Elevator::Elevator() 
-    : currentFloor(1)  // 初始在1楼
-    , capacity(ElevatorConfig::MAX_CAPACITY)
-    , state(ElevatorState::IDLE)
-    , idleTimer(0.0)
-{
-}
-
-void Elevator::move() {
-    switch (state) {
-        case ElevatorState::MOVING_UP:
-            if (currentFloor < ElevatorConfig::FLOOR_COUNT) {
-                currentFloor++;
-            }
-            break;
-        case ElevatorState::MOVING_DOWN:
-            if (currentFloor > 1) {
-                currentFloor--;
-            }
-            break;
-        default:
-            break;
-    }
-}
-
-bool Elevator::addPassenger(const Passenger& passenger) {
-    if (passengers.size() >= capacity) {
-        return false;
-    }
-    passengers.push_back(passenger);
-    return true;
-}
-
-void Elevator::removePassenger(int floor) {
-    passengers.erase(
-        std::remove_if(passengers.begin(), passengers.end(),
-            [floor](const Passenger& p) { return p.targetFloor == floor; }),
-        passengers.end()
-    );
-}
-
-void Elevator::update(double deltaTime) {
-    if (state == ElevatorState::IDLE) {
-        idleTimer += deltaTime;
-        if (idleTimer >= ElevatorConfig::IDLE_MAX_TIME) {
-            if (currentFloor != 1) {
-                state = ElevatorState::MOVING_DOWN;
-            }
-            idleTimer = 0;
-        }
-    }
-}
-
-int Elevator::getCurrentFloor() const {
-    return currentFloor;
-}
-
-int Elevator::getCurrentLoad() const {
-    return passengers.size();
-}
-
-ElevatorState Elevator::getState() const {
-    return state;
-}
-
-void Elevator::setState(ElevatorState newState) {
-    state = newState;
-    if (state != ElevatorState::IDLE) {
-        idleTimer = 0.0;
-    }
-}
-
-bool Elevator::hasStopRequest(int floor) const {
-    for (const auto& passenger : passengers) {
-        if (passenger.targetFloor == floor) {
-            return true;
-        }
-    }
-    return false;
-}
-
-void Elevator::updateMovement(double deltaTime) {
-    static double moveTimer = 0.0;
-    moveTimer += deltaTime;
-
-    if (moveTimer >= ElevatorConfig::FLOOR_TIME) {
-        moveTimer = 0.0;
-        move();
-        
-        if (hasStopRequest(currentFloor)) {
-            setState(ElevatorState::STOPPED);
-            removePassenger(currentFloor);
-        }
-    }
-} 
\ No newline at end of file
+#include "Elevator.h"
+#include "Constants.h"
+#include "BitOps.h"
+#include <algorithm>
+
+Elevator::Elevator() 
+    : alightCount{}
+    , stopMask(0)
+    , currentFloor(1)  // 初始在1楼
+    , direction(0)
+    , dispatchFloor(-1)
+    , capacity(ElevatorConfig::MAX_CAPACITY)
+    , load(0)
+    , state(ElevatorState::IDLE)
+{
+}
+
+void Elevator::move() {
+    switch (state) {
+        case ElevatorState::MOVING_UP:
+            if (currentFloor < ElevatorConfig::FLOOR_COUNT) {
+                currentFloor++;
+            }
+            break;
+        case ElevatorState::MOVING_DOWN:
+            if (currentFloor > 1) {
+                currentFloor--;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void Elevator::moveTo(int floor) {
+    if (floor >= 1 && floor <= ElevatorConfig::FLOOR_COUNT) {
+        currentFloor = static_cast<int8_t>(floor);
+    }
+}
+
+bool Elevator::addPassenger(PassengerHandle handle, const Passenger& passenger) {
+    if (load + passenger.count > capacity) {
+        return false;
+    }
+    uint8_t count = static_cast<uint8_t>(passenger.count);
+    passengers.push_back(Rider{handle, passenger.targetFloor, count});
+    load += count;
+    alightCount[passenger.targetFloor - 1] += count;
+    stopMask |= BitOps::floorBit(passenger.targetFloor);
+    return true;
+}
+
+void Elevator::removePassenger(int floor, std::vector<PassengerHandle>& alighted) {
+    if ((stopMask & BitOps::floorBit(floor)) == 0) return;
+
+    // 载客数直接按该层下车人数扣减，车内句柄只在确有人下车时整理一次
+    load -= alightCount[floor - 1];
+    alightCount[floor - 1] = 0;
+    stopMask &= ~BitOps::floorBit(floor);
+
+    auto firstLeaving = std::partition(passengers.begin(), passengers.end(),
+        [floor](const Rider& rider) { return rider.targetFloor != floor; });
+    for (auto it = firstLeaving; it != passengers.end(); ++it) {
+        alighted.push_back(it->handle);
+    }
+    passengers.erase(firstLeaving, passengers.end());
+}
+
+const Elevator::RiderList& Elevator::getPassengers() const {
+    return passengers;
+}
+
+int Elevator::getCurrentFloor() const {
+    return currentFloor;
+}
+
+int Elevator::getCurrentLoad() const {
+    return load;
+}
+
+ElevatorState Elevator::getState() const {
+    return state;
+}
+
+void Elevator::setState(ElevatorState newState) {
+    state = newState;
+    if (state == ElevatorState::MOVING_UP) {
+        direction = 1;
+    } else if (state == ElevatorState::MOVING_DOWN) {
+        direction = -1;
+    } else if (state == ElevatorState::IDLE) {
+        direction = 0;
+    }
+}
+
+bool Elevator::hasStopRequest(int floor) const {
+    return (stopMask & BitOps::floorBit(floor)) != 0;
+}
+
+bool Elevator::hasRequestAbove() const {
+    return (stopMask & BitOps::maskAbove(currentFloor)) != 0;
+}
+
+bool Elevator::hasRequestBelow() const {
+    return (stopMask & BitOps::maskBelow(currentFloor)) != 0;
+}
+
+uint32_t Elevator::getStopMask() const {
+    return stopMask;
+}
+
+int Elevator::getDirection() const {
+    return direction;
+}
+
+int Elevator::getDispatchFloor() const {
+    return dispatchFloor;
+}
+
+void Elevator::setDispatchFloor(int floor) {
+    dispatchFloor = static_cast<int8_t>(floor);
+}
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "ElevatorFleet.h"
+#include "BitOps.h"
+#include <climits>
+#include <random>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#define FLEET_AVX2 1
+#define FLEET_AVX2_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FLEET_AVX2 1
+#define FLEET_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define FLEET_AVX2 0
+#endif
+
+#if FLEET_AVX2
+#include <immintrin.h>
+#endif
+
+namespace {
+    // 装不下整组乘客的电梯在代价上加一个远大于任何到达时间的偏置，排在能装下的之后
+    constexpr int64_t OVERFLOW_BIAS = int64_t(1) << 61;
+
+    struct KernelInput {
+        const int64_t* floors;
+        const int64_t* motions;
+        const int64_t* loads;
+        const int64_t* anchors;
+        const int64_t* offsets;
+        int stride;
+        int64_t now;
+        int64_t source;
+        int64_t target;
+        int64_t count;
+        ElevatorFleet::Filter filter;
+    };
+
+    // 不满足筛选条件的电梯返回 INT64_MAX
+    int64_t laneKey(const KernelInput& in, int i) {
+        int64_t floor = in.floors[i];
+        int64_t motion = in.motions[i];
+        bool up = motion == ElevatorFleet::MOVING_UP && in.target > floor;
+        bool down = motion == ElevatorFleet::MOVING_DOWN && in.target < floor;
+        if (in.filter == ElevatorFleet::Filter::MOVING_TOWARD_SOURCE) {
+            up = up && in.source >= floor;
+            down = down && in.source <= floor;
+        }
+        bool ok = up || down || (in.filter == ElevatorFleet::Filter::AVAILABLE && motion == ElevatorFleet::IDLE);
+        if (!ok || in.loads[i] >= ElevatorConfig::MAX_CAPACITY) return INT64_MAX;
+
+        int64_t key = (in.anchors[i] > in.now ? in.anchors[i] : in.now) + in.offsets[i];
+        if (in.loads[i] + in.count > ElevatorConfig::MAX_CAPACITY) key += OVERFLOW_BIAS;
+        return key;
+    }
+
+    int bestCarScalar(const KernelInput& in) {
+        int best = -1;
+        int64_t bestKey = INT64_MAX;
+        for (int i = 0; i < in.stride; ++i) {
+            int64_t key = laneKey(in, i);
+            if (key < bestKey) {
+                bestKey = key;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // 从乘客所在楼层向两侧逐层取出停在（或将停在）该层的电梯。到达时间不少于锚点楼层
+    // 到乘客楼层的直达运行时间，距离 d 的下界已超过最优值时后面的电梯都不必再看
+    int bestCarByFloor(const KernelInput& in, const CarFloorIndex& index, const MotionModel& motion) {
+        int best = -1;
+        int64_t bestKey = INT64_MAX;
+        auto visit = [&](int car) {
+            int64_t key = laneKey(in, car);
+            if (key < bestKey || (key == bestKey && key != INT64_MAX && car < best)) {
+                bestKey = key;
+                best = car;
+            }
+        };
+
+        const int source = static_cast<int>(in.source);
+        const int firstCategory = in.filter == ElevatorFleet::Filter::AVAILABLE ? CarFloorIndex::IDLE
+                                                                                : CarFloorIndex::MOVING_UP;
+        for (int d = 0; d < ElevatorConfig::FLOOR_COUNT; ++d) {
+            if (best >= 0 && in.now + motion.travelTime(source, source + d) > bestKey) break;
+            for (int side = 0; side < (d == 0 ? 1 : 2); ++side) {
+                int floor = side == 0 ? source - d : source + d;
+                if (floor < 1 || floor > ElevatorConfig::FLOOR_COUNT) continue;
+                for (int category = firstCategory; category <= CarFloorIndex::MOVING_DOWN; ++category) {
+                    index.forEachCar(static_cast<CarFloorIndex::Category>(category), floor, visit);
+                }
+            }
+        }
+        return best;
+    }
+
+#if FLEET_AVX2
+    FLEET_AVX2_TARGET
+    int bestCarAvx2(const KernelInput& in) {
+        const __m256i one = _mm256_set1_epi64x(1);
+        const __m256i minusOne = _mm256_set1_epi64x(-1);
+        const __m256i idle = _mm256_setzero_si256();
+        const __m256i capacity = _mm256_set1_epi64x(ElevatorConfig::MAX_CAPACITY);
+        const __m256i roomLimit = _mm256_set1_epi64x(ElevatorConfig::MAX_CAPACITY - in.count);
+        const __m256i bias = _mm256_set1_epi64x(OVERFLOW_BIAS);
+        const __m256i never = _mm256_set1_epi64x(INT64_MAX);
+        const __m256i now = _mm256_set1_epi64x(in.now);
+        const __m256i source = _mm256_set1_epi64x(in.source);
+        const __m256i target = _mm256_set1_epi64x(in.target);
+        const __m256i step = _mm256_set1_epi64x(ElevatorFleet::LANES);
+
+        __m256i bestKey = never;
+        __m256i bestIndex = minusOne;
+        __m256i index = _mm256_setr_epi64x(0, 1, 2, 3);
+        for (int i = 0; i < in.stride; i += ElevatorFleet::LANES) {
+            __m256i floor = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.floors + i));
+            __m256i motion = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.motions + i));
+            __m256i load = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.loads + i));
+            __m256i anchor = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.anchors + i));
+            __m256i offset = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in.offsets + i));
+
+            __m256i up = _mm256_and_si256(_mm256_cmpeq_epi64(motion, one), _mm256_cmpgt_epi64(target, floor));
+            __m256i down = _mm256_and_si256(_mm256_cmpeq_epi64(motion, minusOne), _mm256_cmpgt_epi64(floor, target));
+            if (in.filter == ElevatorFleet::Filter::MOVING_TOWARD_SOURCE) {
+                up = _mm256_andnot_si256(_mm256_cmpgt_epi64(floor, source), up);
+                down = _mm256_andnot_si256(_mm256_cmpgt_epi64(source, floor), down);
+            }
+            __m256i ok = _mm256_or_si256(up, down);
+            if (in.filter == ElevatorFleet::Filter::AVAILABLE) {
+                ok = _mm256_or_si256(ok, _mm256_cmpeq_epi64(motion, idle));
+            }
+            ok = _mm256_and_si256(ok, _mm256_cmpgt_epi64(capacity, load));
+
+            __m256i start = _mm256_blendv_epi8(anchor, now, _mm256_cmpgt_epi64(now, anchor));
+            __m256i key = _mm256_add_epi64(start, offset);
+            key = _mm256_add_epi64(key, _mm256_and_si256(_mm256_cmpgt_epi64(load, roomLimit), bias));
+            key = _mm256_blendv_epi8(never, key, ok);
+
+            // 严格小于才替换，同一通道里下标小的电梯优先
+            __m256i better = _mm256_cmpgt_epi64(bestKey, key);
+            bestKey = _mm256_blendv_epi8(bestKey, key, better);
+            bestIndex = _mm256_blendv_epi8(bestIndex, index, better);
+            index = _mm256_add_epi64(index, step);
+        }
+
+        alignas(32) int64_t keys[ElevatorFleet::LANES];
+        alignas(32) int64_t indices[ElevatorFleet::LANES];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(keys), bestKey);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(indices), bestIndex);
+        int best = -1;
+        int64_t minKey = INT64_MAX;
+        for (int lane = 0; lane < ElevatorFleet::LANES; ++lane) {
+            if (indices[lane] < 0) continue;
+            if (keys[lane] < minKey || (keys[lane] == minKey && indices[lane] < best)) {
+                minKey = keys[lane];
+                best = static_cast<int>(indices[lane]);
+            }
+        }
+        return best;
+    }
+#endif
+}
+
+void ElevatorFleet::resize(int carCount) {
+    cars = carCount;
+    stride = (carCount + LANES - 1) / LANES * LANES;
+    // 补齐的通道标记为满载停靠，任何筛选条件下都不会被选中
+    floors.assign(stride, 1);
+    motions.assign(stride, STOPPED);
+    loads.assign(stride, ElevatorConfig::MAX_CAPACITY);
+    anchors.assign(stride, 0);
+    offsets.assign(static_cast<size_t>(ElevatorConfig::FLOOR_COUNT) * 2 * stride, 0);
+    profiles.assign(carCount, EtaProfile());
+    floorIndex.resize(carCount);
+}
+
+void ElevatorFleet::update(int car, const CarStatus& status, const MotionModel& motion) {
+    floors[car] = status.floor;
+    motions[car] = status.motion;
+    loads[car] = status.load;
+    anchors[car] = status.anchorTime;
+
+    CarFloorIndex::Category category = status.motion == IDLE ? CarFloorIndex::IDLE :
+                                       status.motion == MOVING_UP ? CarFloorIndex::MOVING_UP :
+                                       status.motion == MOVING_DOWN ? CarFloorIndex::MOVING_DOWN :
+                                       CarFloorIndex::STOPPED;
+    floorIndex.update(car, status.anchorFloor, category, status.dispatchFloor);
+
+    EtaProfile& profile = profiles[car];
+    if (!profile.update(status.anchorFloor, status.direction, status.stops, status.stopsAtAnchor, motion)) return;
+    for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
+        offsets[static_cast<size_t>(queueIndex(floor, true)) * stride + car] = profile.offset(floor, true);
+        offsets[static_cast<size_t>(queueIndex(floor, false)) * stride + car] = profile.offset(floor, false);
+    }
+}
+
+void ElevatorFleet::invalidateProfiles() {
+    for (auto& profile : profiles) {
+        profile.invalidate();
+    }
+}
+
+bool ElevatorFleet::hasAvx2() {
+#if defined(__AVX2__)
+    return true;
+#elif FLEET_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+int ElevatorFleet::bestCarWith(Kernel kernel, const Passenger& passenger, Filter filter, SimTime now,
+                               const MotionModel& motion) const {
+    const bool up = passenger.targetFloor > passenger.sourceFloor;
+    KernelInput in{floors.data(), motions.data(), loads.data(), anchors.data(),
+                   offsets.data() + static_cast<size_t>(queueIndex(passenger.sourceFloor, up)) * stride,
+                   stride, now, passenger.sourceFloor, passenger.targetFloor, passenger.count, filter};
+    if (kernel == Kernel::AUTO) {
+        kernel = cars > FLOOR_SEARCH_MIN_CARS ? Kernel::FLOOR_SEARCH : hasAvx2() ? Kernel::AVX2 : Kernel::SCALAR;
+    }
+    switch (kernel) {
+        case Kernel::FLOOR_SEARCH:
+            return bestCarByFloor(in, floorIndex, motion);
+#if FLEET_AVX2
+        case Kernel::AVX2:
+            return bestCarAvx2(in);
+#endif
+        default:
+            return bestCarScalar(in);
+    }
+}
+
+long long ElevatorFleet::selfCheck(int maxCars, int rounds, unsigned seed) {
+    const int floorCount = ElevatorConfig::FLOOR_COUNT;
+    std::mt19937 gen(seed);
+    auto pick = [&gen](int low, int high) { return std::uniform_int_distribution<>(low, high)(gen); };
+    MotionModel motion;
+    const SimTime now = SimClock::fromSimSeconds(1.0);
+    const SimTime step = std::max<SimTime>(motion.travelTime(1, 2), 1);
+    const Filter filters[] = {Filter::AVAILABLE, Filter::MOVING_TOWARD_TARGET, Filter::MOVING_TOWARD_SOURCE};
+    const bool avx2 = hasAvx2();
+
+    long long mismatches = 0;
+    for (int carCount = 1; carCount <= maxCars; ++carCount) {
+        ElevatorFleet fleet;
+        fleet.resize(carCount);
+        for (int round = 0; round < rounds; ++round) {
+            // 状态取值范围故意很小，让不同电梯的代价经常相等，检查并列时是否都选下标小的
+            for (int car = 0; car < carCount; ++car) {
+                CarStatus status{};
+                status.floor = pick(1, floorCount);
+                status.load = pick(0, ElevatorConfig::MAX_CAPACITY);
+                status.anchorFloor = status.floor;
+                status.dispatchFloor = pick(0, 3) == 0 ? pick(1, floorCount) : -1;
+                status.stops = static_cast<uint32_t>(gen()) & gen() & BitOps::maskBelow(floorCount + 1);
+                switch (pick(0, 3)) {
+                    case 0:
+                        status.motion = IDLE;
+                        break;
+                    case 1:
+                        status.motion = STOPPED;
+                        status.anchorTime = now + step * pick(0, 2);
+                        status.direction = (status.stops & ~BitOps::floorBit(status.floor)) != 0 ? pick(0, 1) * 2 - 1 : 0;
+                        break;
+                    default:
+                        status.motion = pick(0, 1) * 2 - 1;
+                        status.direction = static_cast<int>(status.motion);
+                        status.anchorFloor = std::min(std::max(status.floor + status.direction, 1), floorCount);
+                        status.anchorTime = now + step * pick(0, 2);
+                        status.stopsAtAnchor = (status.stops & BitOps::floorBit(status.anchorFloor)) != 0;
+                        break;
+                }
+                fleet.update(car, status, motion);
+            }
+
+            for (int source = 1; source <= floorCount; ++source) {
+                int target = pick(1, floorCount - 1);
+                if (target >= source) ++target;
+                Passenger passenger(source, target, now, now, pick(1, ElevatorConfig::MAX_CAPACITY));
+                for (Filter filter : filters) {
+                    int expected = fleet.bestCarWith(Kernel::SCALAR, passenger, filter, now, motion);
+                    if (avx2 && fleet.bestCarWith(Kernel::AVX2, passenger, filter, now, motion) != expected) {
+                        ++mismatches;
+                    }
+                    if (fleet.bestCarWith(Kernel::FLOOR_SEARCH, passenger, filter, now, motion) != expected) {
+                        ++mismatches;
+                    }
+                }
+            }
+        }
+    }
+    return mismatches;
+}
@@ -1,436 +1,1632 @@
-#include "ElevatorSystem.h"
-#include "Constants.h"
-#include <fstream>
-#include <random>
-#include <iostream>
-#include <sstream>
-#include "Logger.h"
-#include <iomanip>
-
-ElevatorSystem::ElevatorSystem() 
-    : currentTime(0.0)
-{
-    elevators.resize(ElevatorConfig::ELEVATOR_COUNT);
-    floorRequests.resize(ElevatorConfig::FLOOR_COUNT, 0);
-    hourlyRequests.resize(24, 0);
-    totalRequests = 0;
-    timeoutRequests = 0;
-    totalWaitTime = 0.0;
-}
-
-void ElevatorSystem::start() {
-    currentTime = 0.0;
-    Logger::log("系统启动");
-    while (!waitingPassengers.empty()) {
-        waitingPassengers.pop();
-    }
-}
-
-void ElevatorSystem::reset() {
-    elevators.clear();
-    elevators.resize(ElevatorConfig::ELEVATOR_COUNT);
-    std::fill(floorRequests.begin(), floorRequests.end(), 0);
-    std::fill(hourlyRequests.begin(), hourlyRequests.end(), 0);
-    totalRequests = 0;
-    currentTime = 0.0;
-    while (!waitingPassengers.empty()) {
-        waitingPassengers.pop();
-    }
-}
-
-void ElevatorSystem::update(double deltaTime) {
-    currentTime += deltaTime;
-    
-    for (auto& elevator : elevators) {
-        elevator.update(deltaTime);
-        elevator.updateMovement(deltaTime);
-    }
-    
-    processWaitingPassengers();
-    
-    updateStatistics();
-}
-
-void ElevatorSystem::loadRandomRequests() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    
-    generatePeakTimeRequests(6.0, 8.0, true, gen);  
-    generatePeakTimeRequests(11.0, 12.0, true, gen);
-    generatePeakTimeRequests(13.0, 14.0, false, gen);
-    generatePeakTimeRequests(17.0, 18.0, false, gen);
-    generateNormalTimeRequests(gen);
-}
-
-void ElevatorSystem::loadFileRequests(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "无法打开文件: " << filename << std::endl;
-        return;
-    }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        int hour, minute, second;
-        int from, to, count;
-        char colon1, colon2;
-        
-        std::istringstream iss(line);
-        iss >> hour >> colon1 >> minute >> colon2 >> second;
-        iss >> from >> to >> count;
-        
-        if (iss.fail()) {
-            std::cerr << "无效的输入行: " << line << std::endl;
-            continue;
-        }
-        
-        double time = (hour + minute/60.0 + second/3600.0);
-        
-        addManualRequest(from, to, count, time);
-    }
-}
-
-void ElevatorSystem::addManualRequest(int from, int to, int count, double time) {
-    int hour = static_cast<int>(time) % 24;
-    hourlyRequests[hour] += count;
-    floorRequests[from - 1] += count;
-    floorRequests[to - 1] += count;
-    totalRequests += count;
-    
-    for (int i = 0; i < count; ++i) {
-        waitingPassengers.push(Passenger(from, to, time, time + 60.0));
-    }
-}
-
-void ElevatorSystem::printStatistics() const {
-    std::cout << "\n=== 电梯使用统计 ===\n";
-    
-    std::cout << "楼层请求统计：\n";
-    for (int i = 0; i < ElevatorConfig::FLOOR_COUNT; ++i) {
-        std::cout << "第 " << std::setw(2) << (i + 1) << " 层：" 
-                 << std::setw(4) << floorRequests[i] << " 次请求\n";
-    }
-    
-    std::cout << "\n时段请求统计：\n";
-    for (int i = 0; i < 24; ++i) {
-        double requestRate = totalRequests > 0 ? 
-            (static_cast<double>(hourlyRequests[i]) / totalRequests * 100) : 0.0;
-        
-        std::cout << std::setw(2) << i << ":00 - " << std::setw(2) << (i + 1) 
-                 << ":00：" << std::fixed << std::setprecision(1) 
-                 << std::setw(5) << requestRate << "% 的乘客请求\n";
-    }
-
-    std::cout << "\n高峰期分析：\n";
-    int morningRequests = 0;
-    for (int i = 6; i < 8; ++i) {
-        morningRequests += hourlyRequests[i];
-    }
-    double morningRate = totalRequests > 0 ? 
-        (static_cast<double>(morningRequests) / totalRequests * 100) : 0.0;
-    
-    double noonRate = totalRequests > 0 ? 
-        (static_cast<double>(hourlyRequests[11]) / totalRequests * 100) : 0.0;
-    
-    double lunchRate = totalRequests > 0 ? 
-        (static_cast<double>(hourlyRequests[13]) / totalRequests * 100) : 0.0;
-    
-    double eveningRate = totalRequests > 0 ? 
-        (static_cast<double>(hourlyRequests[17]) / totalRequests * 100) : 0.0;
-    
-    std::cout << "早高峰 (6:00-8:00)   请求比例：" << std::setprecision(1) << morningRate << "%\n"
-              << "午高峰 (11:00-12:00) 请求比例：" << noonRate << "%\n"
-              << "午休高峰 (13:00-14:00) 请求比例：" << lunchRate << "%\n"
-              << "晚高峰 (17:00-18:00) 请求比例：" << eveningRate << "%\n"
-              << "\n总请求数：" << totalRequests << " 次\n";
-}
-
-void ElevatorSystem::printCurrentStatus() const {
-    std::cout << "\n=== 当前电梯状态 ===\n";
-    for (size_t i = 0; i < elevators.size(); ++i) {
-        const auto& elevator = elevators[i];
-        std::cout << "电梯 " << (i + 1) << "：\n"
-                 << "  当前楼层：" << elevator.getCurrentFloor() << "\n"
-                 << "  载客数量：" << elevator.getCurrentLoad() << "\n"
-                 << "  状态：";
-        
-        switch (elevator.getState()) {
-            case ElevatorState::IDLE: std::cout << "空闲"; break;
-            case ElevatorState::MOVING_UP: std::cout << "上行"; break;
-            case ElevatorState::MOVING_DOWN: std::cout << "下行"; break;
-            case ElevatorState::STOPPED: std::cout << "停止"; break;
-        }
-        std::cout << "\n\n";
-    }
-
-    int hour = static_cast<int>(currentTime);
-    int minute = static_cast<int>((currentTime - hour) * 60);
-    int second = static_cast<int>((currentTime - hour - minute/60.0) * 3600);
-    
-    std::cout << "当前时间：" 
-              << std::setfill('0') << std::setw(2) << hour << ":"
-              << std::setfill('0') << std::setw(2) << minute << ":"
-              << std::setfill('0') << std::setw(2) << second << "\n";
-}
-
-void ElevatorSystem::processWaitingPassengers() {
-    if (waitingPassengers.empty()) return;
-
-    while (!waitingPassengers.empty()) {
-        const auto& passenger = waitingPassengers.front();
-        if (currentTime - passenger.requestTime > passenger.waitTimeout) {
-            timeoutRequests++;
-            std::string msg = "乘客请求超时：从" + std::to_string(passenger.sourceFloor) 
-                             + "层到" + std::to_string(passenger.targetFloor) + "层";
-            Logger::log(msg);
-            waitingPassengers.pop();
-            continue;
-        }
-        totalWaitTime += (currentTime - passenger.requestTime);
-        break;
-    }
-
-    for (auto& elevator : elevators) {
-        if (elevator.getState() == ElevatorState::IDLE) {
-            if (!waitingPassengers.empty()) {
-                const auto& passenger = waitingPassengers.front();
-                if (elevator.getCurrentFloor() == passenger.sourceFloor) {
-                    if (elevator.addPassenger(passenger)) {
-                        waitingPassengers.pop();
-                        elevator.setState(passenger.targetFloor > passenger.sourceFloor ? 
-                            ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN);
-                    }
-                }
-            }
-        }
-    }
-}
-
-void ElevatorSystem::generatePeakTimeRequests(double startHour, double endHour, bool isUpPeak, std::mt19937& gen) {
-    double timeRange = (endHour - startHour) * 3600;
-    std::uniform_real_distribution<> timeDist(0, timeRange);
-    std::uniform_int_distribution<> floorDist(2, ElevatorConfig::FLOOR_COUNT);
-    std::uniform_int_distribution<> countDist(1, 4);
-
-    for (int i = 0; i < requestConfig.peakTimeRequests; ++i) {
-        double relativeTime = timeDist(gen);
-        double time = startHour + (relativeTime / 3600.0);
-        
-        int count = countDist(gen);
-        
-        if (isUpPeak) {
-            int targetFloor = floorDist(gen);
-            addManualRequest(1, targetFloor, count, time);
-        } else {
-            int sourceFloor = floorDist(gen);
-            addManualRequest(sourceFloor, 1, count, time);
-        }
-    }
-}
-
-void ElevatorSystem::generateNormalTimeRequests(std::mt19937& gen) {
-    std::vector<std::pair<double, double>> normalHours = {
-        {0.0, 6.0},    // 凌晨
-        {8.0, 11.0},   // 上午
-        {12.0, 13.0},  // 中午
-        {14.0, 17.0},  // 下午
-        {18.0, 24.0}   // 晚上
-    };
-    
-    std::uniform_int_distribution<> floorDist(1, ElevatorConfig::FLOOR_COUNT);
-    std::uniform_int_distribution<> countDist(1, 3);
-    
-    for (int i = 0; i < requestConfig.normalTimeRequests; ++i) {
-        int periodIndex = std::uniform_int_distribution<>(0, normalHours.size() - 1)(gen);
-        auto period = normalHours[periodIndex];
-        
-        double time = std::uniform_real_distribution<>(period.first, period.second)(gen);
-        
-        int sourceFloor = floorDist(gen);
-        int targetFloor;
-        do {
-            targetFloor = floorDist(gen);
-        } while (targetFloor == sourceFloor);
-        
-        int count = countDist(gen);
-        addManualRequest(sourceFloor, targetFloor, count, time);
-    }
-}
-
-void ElevatorSystem::updateStatistics() {
-    for (const auto& elevator : elevators) {
-        int floor = elevator.getCurrentFloor();
-        if (elevator.getState() != ElevatorState::IDLE) {
-            floorRequests[floor - 1]++;
-        }
-    }
-
-    int currentHour = static_cast<int>(currentTime) % 24;
-    int activeElevators = 0;
-    for (const auto& elevator : elevators) {
-        if (elevator.getState() != ElevatorState::IDLE) {
-            activeElevators++;
-        }
-    }
-    
-    if (activeElevators > 0) {
-        hourlyRequests[currentHour]++;
-    }
-}
-
-void ElevatorSystem::assignElevator(const Passenger& passenger) {
-    int bestElevatorIndex = findBestElevator(passenger);
-    if (bestElevatorIndex >= 0) {
-        auto& elevator = elevators[bestElevatorIndex];
-        if (elevator.addPassenger(passenger)) {
-            if (elevator.getState() == ElevatorState::IDLE) {
-                elevator.setState(passenger.targetFloor > passenger.sourceFloor ? 
-                    ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN);
-            }
-        }
-    }
-}
-
-bool ElevatorSystem::isElevatorAvailable(const Elevator& elevator, const Passenger& passenger) const {
-    if (elevator.getCurrentLoad() >= ElevatorConfig::MAX_CAPACITY) {
-        return false;
-    }
-
-    switch (elevator.getState()) {
-        case ElevatorState::IDLE:
-            return true;
-        case ElevatorState::MOVING_UP:
-            return passenger.targetFloor > elevator.getCurrentFloor();
-        case ElevatorState::MOVING_DOWN:
-            return passenger.targetFloor < elevator.getCurrentFloor();
-        default:
-            return false;
-    }
-}
-
-int ElevatorSystem::findBestElevator(const Passenger& passenger) const {
-    switch (currentStrategy) {
-        case ElevatorStrategy::NEAREST_FIRST:
-            return findNearestElevator(passenger);
-        case ElevatorStrategy::SCAN:
-            return findScanElevator(passenger);
-        case ElevatorStrategy::LOOK:
-            return findLookElevator(passenger);
-        default:
-            return findNearestElevator(passenger);
-    }
-}
-
-int ElevatorSystem::findNearestElevator(const Passenger& passenger) const {
-    int bestIndex = -1;
-    int minDistance = INT_MAX;
-
-    for (size_t i = 0; i < elevators.size(); ++i) {
-        const auto& elevator = elevators[i];
-        if (!isElevatorAvailable(elevator, passenger)) {
-            continue;
-        }
-
-        int distance = std::abs(elevator.getCurrentFloor() - passenger.sourceFloor);
-        if (distance < minDistance) {
-            minDistance = distance;
-            bestIndex = i;
-        }
-    }
-
-    return bestIndex;
-}
-
-int ElevatorSystem::findScanElevator(const Passenger& passenger) const {
-    int bestIndex = -1;
-    int minDistance = INT_MAX;
-
-    for (size_t i = 0; i < elevators.size(); ++i) {
-        const auto& elevator = elevators[i];
-        if (!isElevatorAvailable(elevator, passenger)) {
-            continue;
-        }
-
-        if (elevator.getState() == ElevatorState::MOVING_UP && 
-            passenger.targetFloor > elevator.getCurrentFloor()) {
-            int distance = std::abs(elevator.getCurrentFloor() - passenger.sourceFloor);
-            if (distance < minDistance) {
-                minDistance = distance;
-                bestIndex = i;
-            }
-        }
-        else if (elevator.getState() == ElevatorState::MOVING_DOWN && 
-                 passenger.targetFloor < elevator.getCurrentFloor()) {
-            int distance = std::abs(elevator.getCurrentFloor() - passenger.sourceFloor);
-            if (distance < minDistance) {
-                minDistance = distance;
-                bestIndex = i;
-            }
-        }
-    }
-
-    return bestIndex >= 0 ? bestIndex : findNearestElevator(passenger);
-}
-
-int ElevatorSystem::findLookElevator(const Passenger& passenger) const {
-    int bestIndex = -1;
-    int minDistance = INT_MAX;
-
-    for (size_t i = 0; i < elevators.size(); ++i) {
-        const auto& elevator = elevators[i];
-        if (!isElevatorAvailable(elevator, passenger)) {
-            continue;
-        }
-
-        if ((elevator.getState() == ElevatorState::MOVING_UP && 
-             passenger.sourceFloor >= elevator.getCurrentFloor()) ||
-            (elevator.getState() == ElevatorState::MOVING_DOWN && 
-             passenger.sourceFloor <= elevator.getCurrentFloor())) {
-            int distance = std::abs(elevator.getCurrentFloor() - passenger.sourceFloor);
-            if (distance < minDistance) {
-                minDistance = distance;
-                bestIndex = i;
-            }
-        }
-    }
-
-    return bestIndex >= 0 ? bestIndex : findNearestElevator(passenger);
-}
-
-void ElevatorSystem::setElevatorSpeed(double speed) {
-    ElevatorConfig::setFloorTime(speed);
-}
-
-void ElevatorSystem::setMaxWaitTime(double time) {
-    ElevatorConfig::setMaxWaitTime(time);
-}
-
-void ElevatorSystem::setMaxIdleTime(double time) {
-    ElevatorConfig::setIdleMaxTime(time);
-}
-
-void ElevatorSystem::setRequestCounts(int peakCount, int normalCount) {
-    if (peakCount > 0) requestConfig.peakTimeRequests = peakCount;
-    if (normalCount > 0) requestConfig.normalTimeRequests = normalCount;
-}
-
-void ElevatorSystem::setStrategy(ElevatorStrategy strategy) {
-    currentStrategy = strategy;
-    
-    std::string strategyName;
-    switch (strategy) {
-        case ElevatorStrategy::NEAREST_FIRST:
-            strategyName = "就近优先";
-            break;
-        case ElevatorStrategy::SCAN:
-            strategyName = "扫描算法";
-            break;
-        case ElevatorStrategy::LOOK:
-            strategyName = "LOOK算法";
-            break;
-    }
-    Logger::log("电梯策略已更改为: " + strategyName);
-}
+#include "ElevatorSystem.h"
+#include "Constants.h"
+#include <fstream>
+#include <random>
+#include <iostream>
+#include <sstream>
+#include "Logger.h"
+#include "BitOps.h"
+#include <iomanip>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <limits>
+
+namespace {
+    bool parsePriority(const std::string& name, PriorityClass& priority) {
+        if (name == "emergency") {
+            priority = PriorityClass::EMERGENCY;
+        } else if (name == "accessibility") {
+            priority = PriorityClass::ACCESSIBILITY;
+        } else if (name == "normal") {
+            priority = PriorityClass::NORMAL;
+        } else {
+            return false;
+        }
+        return true;
+    }
+}
+
+ElevatorSystem::ElevatorSystem() 
+    : carTimers(ElevatorConfig::ELEVATOR_COUNT)
+    , currentTime(0)
+{
+    elevators.resize(ElevatorConfig::ELEVATOR_COUNT);
+    runs.resize(ElevatorConfig::ELEVATOR_COUNT);
+    fleet.resize(ElevatorConfig::ELEVATOR_COUNT);
+    fleetDirty.assign(ElevatorConfig::ELEVATOR_COUNT, 1);
+    pickups.resize(ElevatorConfig::ELEVATOR_COUNT);
+    floorRequests.resize(ElevatorConfig::FLOOR_COUNT, 0);
+    hourlyRequests.resize(24, 0);
+    totalRequests = 0;
+    timeoutRequests = 0;
+    totalWaitTime = 0.0;
+}
+
+void ElevatorSystem::start() {
+    currentTime = 0;
+    Logger::log("系统启动");
+    clearPassengers();
+    traffic.reset(SimClock::fromSimSeconds(ElevatorConfig::TRAFFIC_WINDOW));
+    strategySwitches = 0;
+    forecast.reset();
+    events.clear();
+    carTimers.reset(elevators.size());
+    utilization.reset(static_cast<int>(elevators.size()), currentTime);
+    rebuildMotion();
+    if (journeysEnabled) publishJourneys();
+}
+
+void ElevatorSystem::reset() {
+    elevators.clear();
+    elevators.resize(ElevatorConfig::ELEVATOR_COUNT);
+    std::fill(floorRequests.begin(), floorRequests.end(), 0);
+    std::fill(hourlyRequests.begin(), hourlyRequests.end(), 0);
+    totalRequests = 0;
+    timeoutRequests = 0;
+    totalWaitTime = 0.0;
+    for (auto& waits : classWaits) {
+        waits.clear();
+    }
+    classWithinTarget.fill(0);
+    classTimeouts.fill(0);
+    journeyLatency.clear();
+    currentTime = 0;
+    clearPassengers();
+    traffic.reset(SimClock::fromSimSeconds(ElevatorConfig::TRAFFIC_WINDOW));
+    strategySwitches = 0;
+    forecast.reset();
+    events.clear();
+    carTimers.reset(elevators.size());
+    utilization.reset(static_cast<int>(elevators.size()), currentTime);
+    rebuildMotion();
+    if (journeysEnabled) publishJourneys();
+}
+
+void ElevatorSystem::clearPassengers() {
+    // 车厢内的乘客句柄随记录池一起失效，电梯回到初始状态；电梯数按当前配置重建
+    elevators.assign(ElevatorConfig::ELEVATOR_COUNT, Elevator());
+    runs.assign(elevators.size(), CarRun());
+    if (fleet.size() != static_cast<int>(elevators.size())) {
+        fleet.resize(static_cast<int>(elevators.size()));
+        fleetDirty.assign(elevators.size(), 1);
+    }
+    pendingArrivals = decltype(pendingArrivals)();
+    arrivalSequence = 0;
+    hallCalls.clear();
+    deadlines.clear();
+    passengerPool.clear();
+    unassignedCalls.clear();
+    priorityCalls.clear();
+    pickups.assign(elevators.size(), PickupCalls());
+    batchScheduled = false;
+    markFleetDirty();
+}
+
+void ElevatorSystem::update(double deltaTime) {
+    advanceTo(currentTime + SimClock::fromSimSeconds(deltaTime));
+}
+
+void ElevatorSystem::runUntil(double endTime) {
+    advanceTo(SimClock::fromSimSeconds(endTime));
+}
+
+void ElevatorSystem::advanceTo(SimTime endTime) {
+    if (endTime < currentTime) return;
+
+    // 两个事件之间系统状态不会变化，直接跳到下一个事件的时刻
+    while (nextWakeupTime() <= endTime) {
+        currentTime = nextWakeupTime();
+        carTimers.advanceTo(currentTime);
+
+        // 先放入新到达的乘客，电梯到站时才能看到同一时刻出现的召唤
+        while (!events.empty() && events.nextTime() <= currentTime) {
+            if (events.pop().type == EventType::DISPATCH_BATCH) {
+                assignDestinationBatch();
+            } else {
+                releaseArrivals();
+            }
+        }
+
+        int elevatorIndex;
+        EventType type;
+        while (carTimers.popDue(elevatorIndex, type)) {
+            handleCarEvent(elevatorIndex, type);
+        }
+
+        expireOverdue();
+        processWaitingPassengers();
+        if (journeysStale && journeysEnabled) publishJourneys();
+        if (metrics && metrics->due()) publishMetrics();
+        if (liveSegment.isOpen()) publishLiveState();
+    }
+
+    currentTime = endTime;
+    carTimers.advanceTo(currentTime);
+    if (journeysStale && journeysEnabled) publishJourneys();
+    if (metrics && metrics->due()) publishMetrics();
+    if (liveSegment.isOpen()) publishLiveState();
+}
+
+SimTime ElevatorSystem::nextWakeupTime() {
+    SimTime next = std::min(events.empty() ? SimClock::NEVER : events.nextTime(), carTimers.nextTime());
+    if (!deadlines.empty()) {
+        next = std::min(next, deadlines.nextDeadline());
+    }
+    return next;
+}
+
+void ElevatorSystem::expireOverdue() {
+    while (!deadlines.empty() && deadlines.nextDeadline() <= currentTime) {
+        DeadlineIndex::Entry entry = deadlines.pop();
+        if (!hallCalls.remove(entry.floor, entry.up, entry.handle)) continue;
+
+        const Passenger& passenger = passengerPool[entry.handle];
+        if (passenger.assignedCar != Passenger::UNASSIGNED) {
+            removePickup(passenger.assignedCar, passenger);
+        }
+        timeoutRequests += passenger.count;
+        classTimeouts[static_cast<int>(passenger.priority)] += passenger.count;
+        Logger::log("乘客请求超时：从" + std::to_string(passenger.sourceFloor) 
+                    + "层到" + std::to_string(passenger.targetFloor) + "层，"
+                    + std::to_string(passenger.count) + "人");
+        passengerPool.release(entry.handle);
+    }
+}
+
+void ElevatorSystem::handleCarEvent(int elevatorIndex, EventType type) {
+    auto& elevator = elevators[elevatorIndex];
+    markFleetDirty(elevatorIndex);
+    switch (type) {
+        case EventType::FLOOR_ARRIVAL: {
+            int fromFloor = elevator.getCurrentFloor();
+            if (motion.isKinematic()) {
+                elevator.moveTo(runs[elevatorIndex].targetFloor);
+            } else {
+                elevator.move();
+            }
+            int floor = elevator.getCurrentFloor();
+            utilization.addTravel(elevatorIndex, currentTime, std::abs(floor - fromFloor));
+            bool reachedDispatch = floor == elevator.getDispatchFloor();
+            if (reachedDispatch) {
+                elevator.setDispatchFloor(-1);
+            }
+
+            // 顺路且未满载时，同方向有召唤的楼层也停靠接客
+            bool pickUp = elevator.getCurrentLoad() < ElevatorConfig::MAX_CAPACITY &&
+                          (pickupMask(elevatorIndex, elevator.getDirection() > 0) & BitOps::floorBit(floor)) != 0;
+            if (elevator.hasStopRequest(floor) || pickUp) {
+                alightedScratch.clear();
+                elevator.removePassenger(floor, alightedScratch);
+                for (PassengerHandle handle : alightedScratch) {
+                    const Passenger& passenger = passengerPool[handle];
+                    journeyLatency.recordArrival(passenger, passenger.boardTick, currentTime);
+                    passengerPool.release(handle);
+                }
+                changeState(elevatorIndex, ElevatorState::STOPPED);
+            } else if (reachedDispatch && elevator.getStopMask() != 0) {
+                // 派梯途中接到的乘客还没送完（满载驶过召唤层时会出现），继续送客而不是停在这里
+                bool ahead = elevator.getDirection() > 0 ? elevator.hasRequestAbove() : elevator.hasRequestBelow();
+                if (ahead) {
+                    startRun(elevatorIndex);
+                } else {
+                    changeState(elevatorIndex, elevator.getDirection() > 0 ?
+                        ElevatorState::MOVING_DOWN : ElevatorState::MOVING_UP);
+                }
+            } else if (reachedDispatch ||
+                       (elevator.getCurrentLoad() == 0 && elevator.getDispatchFloor() < 0 &&
+                        (floor == 1 || floor == ElevatorConfig::FLOOR_COUNT))) {
+                changeState(elevatorIndex, ElevatorState::IDLE);
+            } else if (elevator.getDispatchFloor() > 0 &&
+                       (elevator.getDirection() > 0) != (elevator.getDispatchFloor() > floor)) {
+                // 途中改派的目标已来不及停靠而被驶过，掉头开回去
+                changeState(elevatorIndex, elevator.getDispatchFloor() > floor ?
+                    ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN);
+            } else {
+                startRun(elevatorIndex);
+            }
+            break;
+        }
+        case EventType::DOOR_CLOSE: {
+            int floor = elevator.getCurrentFloor();
+            int target = elevator.getDispatchFloor();
+            bool workAbove = elevator.hasRequestAbove() || target > floor;
+            bool workBelow = elevator.hasRequestBelow() || (target > 0 && target < floor);
+            if (currentStrategy == ElevatorStrategy::DESTINATION_DISPATCH) {
+                // 分配给本梯的同向乘客也算作前方任务，反向的等电梯空闲后再派过去
+                workAbove = workAbove || (pickups[elevatorIndex].upMask & BitOps::maskAbove(floor)) != 0;
+                workBelow = workBelow || (pickups[elevatorIndex].downMask & BitOps::maskBelow(floor)) != 0;
+            }
+            if (!workAbove && !workBelow) {
+                changeState(elevatorIndex, ElevatorState::IDLE);
+            } else {
+                // 当前方向还有任务就继续，否则掉头
+                bool goUp = elevator.getDirection() > 0 ? workAbove : !workBelow;
+                changeState(elevatorIndex, goUp ? ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN);
+            }
+            break;
+        }
+        case EventType::IDLE_TIMEOUT: {
+            int floor = elevator.getCurrentFloor();
+            int parking = ElevatorConfig::FORECAST_PARKING ? chooseParkingFloor(elevatorIndex) : 1;
+            if (parking != floor) {
+                elevator.setDispatchFloor(parking);
+                changeState(elevatorIndex, parking > floor ? ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN);
+            } else if (ElevatorConfig::FORECAST_PARKING) {
+                // 留在原地，过一段空闲时间再按新的预测重新选择
+                carTimers.schedule(elevatorIndex, currentTime + SimClock::fromSimSeconds(ElevatorConfig::IDLE_MAX_TIME),
+                                   EventType::IDLE_TIMEOUT);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+int ElevatorSystem::chooseParkingFloor(int elevatorIndex) const {
+    // 其他空闲电梯所在楼层和各电梯的派梯目标算作已有电梯照应。每层的预计召唤人数乘以
+    // 该层到最近照应楼层的距离作为代价，选停靠后代价下降最多的楼层，由近及远比较，
+    // 同样好时不挪动；预测不到任何召唤时按原来的做法回 1 层
+    int floor = elevators[elevatorIndex].getCurrentFloor();
+    DemandForecast::FloorDemand demand = forecast.demand(currentTime);
+    if (*std::max_element(demand.begin(), demand.end()) <= 0.0) return 1;
+
+    refreshFleet();
+    const CarFloorIndex& index = fleet.index();
+    uint32_t covered = index.targetFloors() | index.floors(CarFloorIndex::IDLE);
+    bool alone = true;
+    index.forEachCar(CarFloorIndex::IDLE, floor, [&](int car) {
+        if (car != elevatorIndex) alone = false;
+    });
+    if (alone) covered &= ~BitOps::floorBit(floor);
+
+    std::array<int, ElevatorConfig::FLOOR_COUNT> distance;
+    for (int g = 1; g <= ElevatorConfig::FLOOR_COUNT; ++g) {
+        distance[g - 1] = ElevatorConfig::FLOOR_COUNT;
+        for (uint32_t mask = covered; mask != 0; mask &= mask - 1) {
+            distance[g - 1] = std::min(distance[g - 1], std::abs(g - BitOps::lowestFloor(mask)));
+        }
+    }
+
+    int best = floor;
+    double bestGain = -1.0;
+    for (int d = 0; d < ElevatorConfig::FLOOR_COUNT; ++d) {
+        for (int side = 0; side < (d == 0 ? 1 : 2); ++side) {
+            int candidate = side == 0 ? floor - d : floor + d;
+            if (candidate < 1 || candidate > ElevatorConfig::FLOOR_COUNT) continue;
+            double gain = 0.0;
+            for (int g = 1; g <= ElevatorConfig::FLOOR_COUNT; ++g) {
+                gain += demand[g - 1] * std::max(0, distance[g - 1] - std::abs(g - candidate));
+            }
+            if (gain > bestGain) {
+                bestGain = gain;
+                best = candidate;
+            }
+        }
+    }
+    return best;
+}
+
+bool ElevatorSystem::saveForecast(const std::string& filename) {
+    forecast.finishDay(currentTime, ElevatorConfig::FORECAST_DECAY);
+    return forecast.save(filename);
+}
+
+void ElevatorSystem::changeState(int elevatorIndex, ElevatorState newState) {
+    auto& elevator = elevators[elevatorIndex];
+    markFleetDirty(elevatorIndex);
+    if (newState == ElevatorState::IDLE) {
+        elevator.setDispatchFloor(-1);
+    }
+    elevator.setState(newState);
+    utilization.update(elevatorIndex, currentTime, newState, elevator.getCurrentLoad());
+    if (newState == ElevatorState::STOPPED) {
+        utilization.addDoorCycle(elevatorIndex, currentTime);
+    }
+
+    // 每个状态只对应一个后续事件，重新设定电梯的计时器即取消旧事件
+    switch (newState) {
+        case ElevatorState::MOVING_UP:
+        case ElevatorState::MOVING_DOWN:
+            startRun(elevatorIndex);
+            break;
+        case ElevatorState::STOPPED:
+            carTimers.schedule(elevatorIndex, currentTime + motion.doorTime(), EventType::DOOR_CLOSE);
+            break;
+        case ElevatorState::IDLE:
+            if (elevator.getCurrentFloor() != 1 || ElevatorConfig::FORECAST_PARKING) {
+                carTimers.schedule(elevatorIndex, currentTime + SimClock::fromSimSeconds(ElevatorConfig::IDLE_MAX_TIME),
+                                   EventType::IDLE_TIMEOUT);
+            } else {
+                carTimers.cancel(elevatorIndex);
+            }
+            break;
+    }
+}
+
+void ElevatorSystem::startRun(int elevatorIndex) {
+    const auto& elevator = elevators[elevatorIndex];
+    markFleetDirty(elevatorIndex);
+    int from = elevator.getCurrentFloor();
+    if (!motion.isKinematic()) {
+        // 匀速模型逐层到站，每到一层再判断是否停靠
+        carTimers.schedule(elevatorIndex, currentTime + motion.travelTime(from, from + 1),
+                           EventType::FLOOR_ARRIVAL);
+        return;
+    }
+
+    int target = planRunTarget(elevatorIndex);
+    runs[elevatorIndex] = CarRun{currentTime, static_cast<int8_t>(from), static_cast<int8_t>(target)};
+    carTimers.schedule(elevatorIndex, motion.arrivalTime(currentTime, from, target), EventType::FLOOR_ARRIVAL);
+}
+
+int ElevatorSystem::planRunTarget(int elevatorIndex) const {
+    // 沿运行方向最近的停靠点：乘客目的层、未满载时的同向召唤层、派梯目标；都没有则开到端站
+    const auto& elevator = elevators[elevatorIndex];
+    int floor = elevator.getCurrentFloor();
+    bool up = elevator.getDirection() > 0;
+    uint32_t stops = elevator.getStopMask();
+    if (elevator.getCurrentLoad() < ElevatorConfig::MAX_CAPACITY) {
+        stops |= pickupMask(elevatorIndex, up);
+    }
+    if (elevator.getDispatchFloor() > 0) {
+        stops |= BitOps::floorBit(elevator.getDispatchFloor());
+    }
+
+    if (up) {
+        stops &= BitOps::maskAbove(floor);
+        return stops != 0 ? BitOps::lowestFloor(stops) : ElevatorConfig::FLOOR_COUNT;
+    }
+    stops &= BitOps::maskBelow(floor);
+    return stops != 0 ? BitOps::highestFloor(stops) : 1;
+}
+
+void ElevatorSystem::retargetRuns() {
+    // 运行途中出现更近的同向召唤时，只要还来得及减速就改停该层
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        const auto& elevator = elevators[i];
+        ElevatorState state = elevator.getState();
+        if (state != ElevatorState::MOVING_UP && state != ElevatorState::MOVING_DOWN) continue;
+
+        CarRun& run = runs[i];
+        int target = planRunTarget(i);
+        bool closer = state == ElevatorState::MOVING_UP ? target < run.targetFloor : target > run.targetFloor;
+        if (!closer || !motion.canStopAt(run.fromFloor, target, currentTime - run.departure)) continue;
+
+        run.targetFloor = static_cast<int8_t>(target);
+        markFleetDirty(i);
+        carTimers.schedule(i, motion.arrivalTime(run.departure, run.fromFloor, target), EventType::FLOOR_ARRIVAL);
+    }
+}
+
+void ElevatorSystem::rebuildMotion() {
+    motion.rebuild();
+    journeyMotion.reset();
+    fleet.invalidateProfiles();
+    markFleetDirty();
+}
+
+void ElevatorSystem::markFleetDirty(int elevatorIndex) {
+    fleetDirty[elevatorIndex] = 1;
+    fleetStale = true;
+    journeysStale = true;
+}
+
+void ElevatorSystem::markFleetDirty() {
+    std::fill(fleetDirty.begin(), fleetDirty.end(), 1);
+    fleetStale = true;
+    journeysStale = true;
+}
+
+void ElevatorSystem::publishJourneys() {
+    journeysStale = false;
+    refreshFleet();
+    if (!journeyMotion) {
+        journeyMotion = std::make_shared<const MotionModel>(motion);
+    }
+
+    // 与 findBestElevator 的筛选一致；前瞻模拟和目的层派梯按就近优先估计
+    std::shared_ptr<JourneyPredictor::Snapshot> snapshot = journeys.acquire();
+    snapshot->time = currentTime;
+    snapshot->fleet = fleet;
+    snapshot->motion = journeyMotion;
+    snapshot->fallback = false;
+    switch (currentStrategy) {
+        case ElevatorStrategy::SCAN:
+            snapshot->filter = ElevatorFleet::Filter::MOVING_TOWARD_TARGET;
+            snapshot->fallback = true;
+            break;
+        case ElevatorStrategy::LOOK:
+            snapshot->filter = ElevatorFleet::Filter::MOVING_TOWARD_SOURCE;
+            snapshot->fallback = true;
+            break;
+        default:
+            snapshot->filter = ElevatorFleet::Filter::AVAILABLE;
+            break;
+    }
+    journeys.publish(std::move(snapshot));
+}
+
+void ElevatorSystem::enableJourneyPrediction(bool enabled) {
+    journeysEnabled = enabled;
+    if (enabled) publishJourneys();
+}
+
+void ElevatorSystem::captureMetrics() {
+    MetricsSnapshot& snapshot = metrics->stage();
+    snapshot.simulatedSeconds = SimClock::toSimSeconds(currentTime);
+    snapshot.requests = totalRequests;
+    snapshot.timeouts = timeoutRequests;
+    snapshot.boarded = 0;
+    for (const auto& waits : classWaits) {
+        snapshot.boarded += static_cast<long long>(waits.count());
+    }
+    snapshot.cars.resize(elevators.size());
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        snapshot.cars[i].floor = elevators[i].getCurrentFloor();
+        snapshot.cars[i].load = elevators[i].getCurrentLoad();
+        snapshot.cars[i].state = elevators[i].getState();
+    }
+    for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
+        snapshot.upQueue[floor - 1] = hallCalls.waitingPeople(floor, true);
+        snapshot.downQueue[floor - 1] = hallCalls.waitingPeople(floor, false);
+    }
+}
+
+void ElevatorSystem::publishLiveState() {
+    liveState.simTicks = currentTime;
+    liveState.carCount = static_cast<uint32_t>(elevators.size());
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        LiveStateData::Car& car = liveState.cars[i];
+        car.floor = static_cast<int8_t>(elevators[i].getCurrentFloor());
+        car.direction = static_cast<int8_t>(elevators[i].getDirection());
+        car.state = static_cast<uint8_t>(elevators[i].getState());
+        car.load = static_cast<uint8_t>(elevators[i].getCurrentLoad());
+    }
+    for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
+        liveState.upQueue[floor - 1] = hallCalls.waitingPeople(floor, true);
+        liveState.downQueue[floor - 1] = hallCalls.waitingPeople(floor, false);
+    }
+    liveSegment.publish(liveState);
+}
+
+bool ElevatorSystem::enableLiveState(const std::string& name) {
+    if (!liveSegment.create(name)) {
+        Logger::log("无法创建共享内存状态段: " + name);
+        return false;
+    }
+    publishLiveState();
+    return true;
+}
+
+void ElevatorSystem::publishMetrics() {
+    captureMetrics();
+    metrics->submit();
+}
+
+void ElevatorSystem::enableMetricsExport(const std::string& filename, double intervalSeconds) {
+    disableMetricsExport();
+    metrics = std::make_unique<MetricsExporter>(filename, intervalSeconds);
+    publishMetrics();
+}
+
+bool ElevatorSystem::disableMetricsExport() {
+    if (!metrics) return true;
+    // 最后一份快照不走 submit，由 stop 阻塞地交给写文件线程，保证写出的是结束时的状态
+    captureMetrics();
+    bool ok = metrics->stop();
+    metrics.reset();
+    return ok;
+}
+
+JourneyPrediction ElevatorSystem::predict(int from, int to, double time) const {
+    return journeys.predict(from, to, SimClock::fromSimSeconds(time));
+}
+
+void ElevatorSystem::refreshFleet() const {
+    if (!fleetStale) return;
+    fleetStale = false;
+
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        if (!fleetDirty[i]) continue;
+        fleetDirty[i] = 0;
+
+        // 锚点为电梯下一次停在某层的时刻：空闲电梯按查询时刻计，开门中为关门时刻，运行中为到站时刻
+        const auto& elevator = elevators[i];
+        ElevatorFleet::CarStatus status{};
+        status.floor = elevator.getCurrentFloor();
+        status.load = elevator.getCurrentLoad();
+        status.anchorFloor = status.floor;
+        status.dispatchFloor = elevator.getDispatchFloor();
+        status.stops = elevator.getStopMask();
+        if (elevator.getDispatchFloor() > 0) {
+            status.stops |= BitOps::floorBit(elevator.getDispatchFloor());
+        }
+        if (currentStrategy == ElevatorStrategy::DESTINATION_DISPATCH) {
+            status.stops |= pickups[i].upMask | pickups[i].downMask;
+        }
+
+        switch (elevator.getState()) {
+            case ElevatorState::IDLE:
+                status.motion = ElevatorFleet::IDLE;
+                break;
+            case ElevatorState::STOPPED:
+                status.motion = ElevatorFleet::STOPPED;
+                status.anchorTime = carTimers.expiry(i);
+                status.direction = (status.stops & ~BitOps::floorBit(status.floor)) != 0 ? elevator.getDirection() : 0;
+                break;
+            case ElevatorState::MOVING_UP:
+            case ElevatorState::MOVING_DOWN:
+                status.motion = elevator.getDirection();
+                status.direction = elevator.getDirection();
+                status.anchorFloor = motion.isKinematic() ? runs[i].targetFloor
+                    : std::min(std::max(status.floor + status.direction, 1), ElevatorConfig::FLOOR_COUNT);
+                status.anchorTime = carTimers.expiry(i);
+                status.stopsAtAnchor = (status.stops & BitOps::floorBit(status.anchorFloor)) != 0;
+                break;
+        }
+        fleet.update(i, status, motion);
+    }
+}
+
+SimTime ElevatorSystem::estimateArrival(int elevatorIndex, const Passenger& passenger) const {
+    refreshFleet();
+    return fleet.eta(elevatorIndex, passenger.sourceFloor, passenger.targetFloor > passenger.sourceFloor, currentTime);
+}
+
+void ElevatorSystem::loadRandomRequests() {
+    std::random_device rd;
+    loadRandomRequests(rd());
+}
+
+void ElevatorSystem::loadRandomRequests(unsigned seed) {
+    std::mt19937 gen(seed);
+    priorityGen.seed(seed);
+    
+    generatePeakTimeRequests(6.0, 8.0, true, gen);  
+    generatePeakTimeRequests(11.0, 12.0, true, gen);
+    generatePeakTimeRequests(13.0, 14.0, false, gen);
+    generatePeakTimeRequests(17.0, 18.0, false, gen);
+    generateNormalTimeRequests(gen);
+}
+
+bool ElevatorSystem::loadFileRequests(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "无法打开文件: " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        
+        int hour, minute, second;
+        int from, to, count;
+        char colon1, colon2;
+        
+        std::istringstream iss(line);
+        iss >> hour >> colon1 >> minute >> colon2 >> second;
+        iss >> from >> to >> count;
+        
+        if (iss.fail()) {
+            std::cerr << "无效的输入行: " << line << std::endl;
+            continue;
+        }
+
+        // 可选的第五列为召唤类别：emergency、accessibility 或 normal
+        PriorityClass priority = PriorityClass::NORMAL;
+        std::string className;
+        if (iss >> className && !parsePriority(className, priority)) {
+            std::cerr << "无效的召唤类别: " << line << std::endl;
+            continue;
+        }
+        
+        addRequestAt(from, to, count, SimClock::fromClock(hour, minute, second), priority);
+    }
+    return true;
+}
+
+void ElevatorSystem::addManualRequest(int from, int to, int count, double time, PriorityClass priority) {
+    addRequestAt(from, to, count, SimClock::fromSimSeconds(time), priority);
+}
+
+PriorityClass ElevatorSystem::randomPriority() {
+    if (ElevatorConfig::EMERGENCY_SHARE <= 0 && ElevatorConfig::ACCESSIBILITY_SHARE <= 0) {
+        return PriorityClass::NORMAL;
+    }
+    double draw = std::uniform_real_distribution<>(0.0, 1.0)(priorityGen);
+    if (draw < ElevatorConfig::EMERGENCY_SHARE) return PriorityClass::EMERGENCY;
+    if (draw < ElevatorConfig::EMERGENCY_SHARE + ElevatorConfig::ACCESSIBILITY_SHARE) {
+        return PriorityClass::ACCESSIBILITY;
+    }
+    return PriorityClass::NORMAL;
+}
+
+void ElevatorSystem::addRequestAt(int from, int to, int count, SimTime time, PriorityClass priority) {
+    if (from == to || from < 1 || to < 1 || count <= 0 ||
+        from > ElevatorConfig::FLOOR_COUNT || to > ElevatorConfig::FLOOR_COUNT) {
+        Logger::log("忽略无效请求：从" + std::to_string(from) + "层到" + std::to_string(to) + "层，"
+                    + std::to_string(count) + "人");
+        return;
+    }
+
+    int hour = static_cast<int>(time / SimClock::TICKS_PER_HOUR % 24);
+    hourlyRequests[hour] += count;
+    floorRequests[from - 1] += count;
+    floorRequests[to - 1] += count;
+    totalRequests += count;
+    
+    // 人数超出记录字段范围的请求拆成多条记录
+    while (count > 0) {
+        int groupSize = std::min(count, static_cast<int>(UINT16_MAX));
+        Passenger group(from, to, time, SimClock::fromSimSeconds(ElevatorConfig::MAX_WAIT_TIME), groupSize, priority);
+        group.status = PassengerStatus::PENDING;
+        pendingArrivals.push(PendingArrival{group.requestTime(), passengerPool.allocate(group), arrivalSequence++});
+        count -= groupSize;
+    }
+    events.schedule(std::max(time, currentTime), EventType::PASSENGER_ARRIVAL);
+}
+
+void ElevatorSystem::printStatistics() const {
+    std::cout << "\n=== 电梯使用统计 ===\n";
+    
+    std::cout << "楼层请求统计：\n";
+    for (int i = 0; i < ElevatorConfig::FLOOR_COUNT; ++i) {
+        std::cout << "第 " << std::setw(2) << (i + 1) << " 层：" 
+                 << std::setw(4) << floorRequests[i] << " 次请求\n";
+    }
+    
+    std::cout << "\n时段请求统计：\n";
+    for (int i = 0; i < 24; ++i) {
+        double requestRate = totalRequests > 0 ? 
+            (static_cast<double>(hourlyRequests[i]) / totalRequests * 100) : 0.0;
+        
+        std::cout << std::setw(2) << i << ":00 - " << std::setw(2) << (i + 1) 
+                 << ":00：" << std::fixed << std::setprecision(1) 
+                 << std::setw(5) << requestRate << "% 的乘客请求\n";
+    }
+
+    std::cout << "\n高峰期分析：\n";
+    int morningRequests = 0;
+    for (int i = 6; i < 8; ++i) {
+        morningRequests += hourlyRequests[i];
+    }
+    double morningRate = totalRequests > 0 ? 
+        (static_cast<double>(morningRequests) / totalRequests * 100) : 0.0;
+    
+    double noonRate = totalRequests > 0 ? 
+        (static_cast<double>(hourlyRequests[11]) / totalRequests * 100) : 0.0;
+    
+    double lunchRate = totalRequests > 0 ? 
+        (static_cast<double>(hourlyRequests[13]) / totalRequests * 100) : 0.0;
+    
+    double eveningRate = totalRequests > 0 ? 
+        (static_cast<double>(hourlyRequests[17]) / totalRequests * 100) : 0.0;
+    
+    std::cout << "早高峰 (6:00-8:00)   请求比例：" << std::setprecision(1) << morningRate << "%\n"
+              << "午高峰 (11:00-12:00) 请求比例：" << noonRate << "%\n"
+              << "午休高峰 (13:00-14:00) 请求比例：" << lunchRate << "%\n"
+              << "晚高峰 (17:00-18:00) 请求比例：" << eveningRate << "%\n"
+              << "\n总请求数：" << totalRequests << " 次\n";
+
+    std::cout << "\n分类候梯统计（真实秒）：\n";
+    for (int c = 0; c < PRIORITY_CLASS_COUNT; ++c) {
+        LatencySummary waits = LatencySummary::of(classWaits[c]);
+        if (waits.count == 0 && classTimeouts[c] == 0) continue;
+        double withinRate = waits.count > 0 ? 100.0 * classWithinTarget[c] / waits.count : 0.0;
+        std::cout << priorityName(static_cast<PriorityClass>(c)) << "：上车 " << waits.count
+                  << " 人，超时 " << classTimeouts[c] << " 人，时限内 " << withinRate << "%，"
+                  << "P50 " << ElevatorConfig::simTimeToRealTime(waits.p50)
+                  << " P90 " << ElevatorConfig::simTimeToRealTime(waits.p90)
+                  << " P99 " << ElevatorConfig::simTimeToRealTime(waits.p99)
+                  << " 最长 " << ElevatorConfig::simTimeToRealTime(waits.max) << "\n";
+    }
+
+    // 分位数按直方图桶上界报告，相对误差约 3%
+    auto printSummary = [](const LatencyHistogram& histogram) {
+        LatencySummary summary = LatencySummary::of(histogram);
+        std::cout << std::setw(6) << summary.count << " 人  P50 " << std::setw(6)
+                  << ElevatorConfig::simTimeToRealTime(summary.p50)
+                  << "  P90 " << std::setw(6) << ElevatorConfig::simTimeToRealTime(summary.p90)
+                  << "  P99 " << std::setw(6) << ElevatorConfig::simTimeToRealTime(summary.p99)
+                  << "  最长 " << std::setw(6) << ElevatorConfig::simTimeToRealTime(summary.max) << "\n";
+    };
+    std::cout << "\n乘客时间分布（真实秒）：\n";
+    for (int m = 0; m < JourneyLatency::METRIC_COUNT; ++m) {
+        auto metric = static_cast<JourneyLatency::Metric>(m);
+        std::cout << JourneyLatency::metricName(metric) << "：";
+        printSummary(journeyLatency.overall(metric));
+    }
+    std::cout << "\n各层候梯时间（真实秒）：\n";
+    for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
+        for (bool up : {true, false}) {
+            const LatencyHistogram& waits = journeyLatency.byFloor(JourneyLatency::WAIT, floor, up);
+            if (waits.count() == 0) continue;
+            std::cout << "第 " << std::setw(2) << floor << " 层" << (up ? "上行" : "下行") << "：";
+            printSummary(waits);
+        }
+    }
+    std::cout << "\n各时段候梯时间（真实秒）：\n";
+    for (int hour = 0; hour < JourneyLatency::HOURS; ++hour) {
+        const LatencyHistogram& waits = journeyLatency.byHour(JourneyLatency::WAIT, hour);
+        if (waits.count() == 0) continue;
+        std::cout << std::setw(2) << hour << ":00 - " << std::setw(2) << (hour + 1) << ":00：";
+        printSummary(waits);
+    }
+
+    // 运行包括上行和下行，开门为停靠开门的时间
+    std::vector<CarUsage> usage = utilization.report(currentTime);
+    auto printUsage = [](const CarUsage& car) {
+        double total = static_cast<double>(std::max<SimTime>(car.totalTicks(), 1));
+        double moving = car.ticks(ElevatorState::MOVING_UP) + car.ticks(ElevatorState::MOVING_DOWN);
+        std::cout << "运行 " << std::setw(5) << moving / total * 100 << "%，开门 " << std::setw(5)
+                  << car.ticks(ElevatorState::STOPPED) / total * 100 << "%，空闲 " << std::setw(5)
+                  << car.ticks(ElevatorState::IDLE) / total * 100 << "%，平均载客 "
+                  << car.loadTicks / total << " 人，运行 " << car.floors << " 层，停靠 "
+                  << car.stops << " 次，开关门 " << car.doorCycles << " 次\n";
+    };
+    std::cout << "\n电梯使用统计：\n";
+    std::vector<CarUsage> hourly(UtilizationTracker::HOURS);
+    for (int car = 0; car < utilization.carCount(); ++car) {
+        CarUsage day;
+        for (int hour = 0; hour < UtilizationTracker::HOURS; ++hour) {
+            day.merge(usage[car * UtilizationTracker::HOURS + hour]);
+            hourly[hour].merge(usage[car * UtilizationTracker::HOURS + hour]);
+        }
+        std::cout << "电梯 " << (car + 1) << "：";
+        printUsage(day);
+    }
+    std::cout << "\n各时段电梯组使用统计：\n";
+    for (int hour = 0; hour < UtilizationTracker::HOURS; ++hour) {
+        if (hourly[hour].totalTicks() == hourly[hour].ticks(ElevatorState::IDLE)) continue;
+        std::cout << std::setw(2) << hour << ":00 - " << std::setw(2) << (hour + 1) << ":00：";
+        printUsage(hourly[hour]);
+    }
+}
+
+SimulationStats ElevatorSystem::getStatistics() const {
+    SimulationStats stats;
+    stats.floorRequests = floorRequests;
+    stats.hourlyRequests = hourlyRequests;
+    stats.totalRequests = totalRequests;
+    stats.timeoutRequests = timeoutRequests;
+    stats.totalWaitTime = totalWaitTime;
+    stats.strategySwitches = strategySwitches;
+    stats.classWaits = classWaits;
+    stats.classWithinTarget = classWithinTarget;
+    stats.classTimeouts = classTimeouts;
+    stats.journeys = journeyLatency;
+    stats.carUsage = utilization.report(currentTime);
+    stats.simulatedTime = SimClock::toSimSeconds(currentTime);
+    return stats;
+}
+
+void ElevatorSystem::printCurrentStatus() const {
+    std::cout << "\n=== 当前电梯状态 ===\n";
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        const auto& elevator = elevators[i];
+        std::cout << "电梯 " << (i + 1) << "：\n"
+                 << "  当前楼层：" << elevator.getCurrentFloor() << "\n"
+                 << "  载客数量：" << elevator.getCurrentLoad() << "\n"
+                 << "  状态：";
+        
+        switch (elevator.getState()) {
+            case ElevatorState::IDLE: std::cout << "空闲"; break;
+            case ElevatorState::MOVING_UP: std::cout << "上行"; break;
+            case ElevatorState::MOVING_DOWN: std::cout << "下行"; break;
+            case ElevatorState::STOPPED: std::cout << "停止"; break;
+        }
+        std::cout << "\n\n";
+    }
+
+    std::cout << "客流模式：" << TrafficClassifier::name(traffic.mode()) << "\n"
+              << "当前时间：" << SimClock::formatClock(currentTime) << "\n";
+}
+
+void ElevatorSystem::releaseArrivals() {
+    while (!pendingArrivals.empty() && pendingArrivals.top().requestTime <= currentTime) {
+        PassengerHandle handle = pendingArrivals.top().handle;
+        pendingArrivals.pop();
+
+        Passenger& passenger = passengerPool[handle];
+        passenger.status = PassengerStatus::WAITING;
+        enqueueCall(handle);
+        deadlines.add(handle);
+        if (passenger.priority != PriorityClass::NORMAL) {
+            // 优先召唤不进目的层派梯的批处理，由 dispatchPriorityCalls 立即指派
+            priorityCalls.push_back(PriorityCall{handle, passenger.serial, -1});
+        } else if (currentStrategy == ElevatorStrategy::DESTINATION_DISPATCH) {
+            unassignedCalls.push_back(UnassignedCall{handle, passenger.serial});
+        }
+
+        forecast.record(passenger.requestTime(), passenger.sourceFloor, passenger.count);
+        TrafficMode mode = traffic.record(passenger.requestTime(), passenger.sourceFloor,
+                                          passenger.targetFloor, passenger.count);
+        if (ElevatorConfig::AUTO_STRATEGY) {
+            applyTrafficMode(mode);
+        }
+    }
+    if (!unassignedCalls.empty()) {
+        scheduleDispatchBatch();
+    }
+}
+
+void ElevatorSystem::printMemoryFootprint() const {
+    size_t waitingBytes = sizeof(Passenger) + sizeof(PassengerHandle) + sizeof(DeadlineIndex::Entry);
+    size_t pendingBytes = sizeof(Passenger) + sizeof(PendingArrival);
+
+    std::cout << "\n=== 内存占用 ===\n"
+              << "乘客记录：" << sizeof(Passenger) << " 字节/组\n"
+              << "候梯乘客：" << waitingBytes << " 字节/组（记录 + 候梯队列句柄 + 超时索引条目）\n"
+              << "未到达乘客：" << pendingBytes << " 字节/组（记录 + 到达堆条目）\n"
+              << "车内乘客：" << sizeof(Elevator::Rider) << " 字节/组（内联存放）\n"
+              << "电梯：" << sizeof(Elevator) << " 字节/部，" << elevators.size() << " 部共 "
+              << sizeof(Elevator) * elevators.size() << " 字节\n"
+              << "记录池：" << passengerPool.slotCapacity() << " 个槽位，"
+              << passengerPool.slabBytes() << " 字节，当前使用 " << passengerPool.liveCount() << " 条\n";
+}
+
+void ElevatorSystem::processWaitingPassengers() {
+    if (hallCalls.empty()) return;
+
+    // 只看停在有召唤楼层的电梯，仍按电梯下标顺序处理
+    refreshFleet();
+    const CarFloorIndex& index = fleet.index();
+    uint32_t boardingFloors = hallCalls.callMask() &
+        (index.floors(CarFloorIndex::IDLE) | index.floors(CarFloorIndex::STOPPED));
+    boardingCars.clear();
+    while (boardingFloors != 0) {
+        int floor = BitOps::lowestFloor(boardingFloors);
+        boardingFloors &= boardingFloors - 1;
+        for (auto category : {CarFloorIndex::IDLE, CarFloorIndex::STOPPED}) {
+            index.forEachCar(category, floor, [this](int car) { boardingCars.push_back(car); });
+        }
+    }
+    std::sort(boardingCars.begin(), boardingCars.end());
+
+    for (int i : boardingCars) {
+        auto& elevator = elevators[i];
+        ElevatorState state = elevator.getState();
+        if (state != ElevatorState::IDLE && state != ElevatorState::STOPPED) continue;
+
+        int floor = elevator.getCurrentFloor();
+        uint32_t bit = BitOps::floorBit(floor);
+        bool callUp = (pickupMask(i, true) & bit) != 0;
+        bool callDown = (pickupMask(i, false) & bit) != 0;
+        if (!callUp && !callDown) continue;
+
+        // 空闲电梯优先接上行乘客；开门停靠的电梯只接同方向乘客，空载时可以掉头
+        bool up;
+        if (state == ElevatorState::IDLE) {
+            up = callUp;
+            if (callUp && callDown &&
+                passengerPool[hallCalls.front(floor, false)].priority < passengerPool[hallCalls.front(floor, true)].priority) {
+                up = false;
+            }
+        } else {
+            up = elevator.getDirection() > 0;
+            if (!(up ? callUp : callDown)) {
+                if (elevator.getCurrentLoad() > 0) continue;
+                up = !up;
+            }
+        }
+
+        int boarded = currentStrategy == ElevatorStrategy::DESTINATION_DISPATCH ?
+            boardAssigned(i, floor, up) : boardPassengers(elevator, floor, up);
+        if (boarded > 0) {
+            markFleetDirty(i);
+            utilization.update(i, currentTime, state, elevator.getCurrentLoad());
+            if (state == ElevatorState::IDLE) {
+                utilization.addDoorCycle(i, currentTime);
+            }
+        }
+        if (boarded > 0 && state == ElevatorState::IDLE) {
+            changeState(i, up ? ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN);
+        }
+    }
+
+    dispatchPriorityCalls();
+    if (currentStrategy == ElevatorStrategy::DESTINATION_DISPATCH) {
+        dispatchAssignedElevators();
+    } else {
+        dispatchIdleElevators();
+    }
+    if (motion.isKinematic()) {
+        retargetRuns();
+    }
+}
+
+int ElevatorSystem::boardPassengers(Elevator& elevator, int floor, bool up) {
+    // 按排队顺序整组上车，装不下的那一组拆分，剩余人员留在队首
+    int boarded = 0;
+    while (hallCalls.hasCall(floor, up)) {
+        int room = ElevatorConfig::MAX_CAPACITY - elevator.getCurrentLoad();
+        if (room <= 0) break;
+
+        PassengerHandle head = hallCalls.front(floor, up);
+        PassengerHandle rider = head;
+        if (passengerPool[head].count > room) {
+            rider = passengerPool.split(head, room);
+            hallCalls.split(floor, up, room);
+        } else {
+            hallCalls.pop(floor, up);
+        }
+
+        passengerPool[rider].status = PassengerStatus::RIDING;
+        elevator.addPassenger(rider, passengerPool[rider]);
+        recordBoarding(passengerPool[rider]);
+        boarded += passengerPool[rider].count;
+    }
+    return boarded;
+}
+
+uint32_t ElevatorSystem::pickupMask(int elevatorIndex, bool up) const {
+    // 目的层派梯时电梯只接分配给自己的乘客，其他策略下任何候梯乘客都可以接
+    if (currentStrategy == ElevatorStrategy::DESTINATION_DISPATCH) {
+        return up ? pickups[elevatorIndex].upMask : pickups[elevatorIndex].downMask;
+    }
+    return up ? hallCalls.upCallMask() : hallCalls.downCallMask();
+}
+
+int ElevatorSystem::boardAssigned(int elevatorIndex, int floor, bool up) {
+    // 按排队顺序接分配给本梯的乘客，优先召唤不论分配给哪部电梯都可以上车；
+    // 先标记为乘梯再一次性移出候梯队列
+    auto& elevator = elevators[elevatorIndex];
+    int boarded = 0;
+    for (PassengerHandle head : hallCalls.queue(floor, up)) {
+        int room = ElevatorConfig::MAX_CAPACITY - elevator.getCurrentLoad();
+        if (room <= 0) break;
+        if (passengerPool[head].assignedCar != elevatorIndex &&
+            passengerPool[head].priority == PriorityClass::NORMAL) continue;
+
+        // 拆分时队首记录留下剩余人数继续候梯，只有上车的那一份改为乘梯
+        PassengerHandle rider = head;
+        if (passengerPool[head].count > room) {
+            rider = passengerPool.split(head, room);
+            hallCalls.split(floor, up, room);
+        }
+        passengerPool[rider].status = PassengerStatus::RIDING;
+        elevator.addPassenger(rider, passengerPool[rider]);
+        if (passengerPool[rider].assignedCar != Passenger::UNASSIGNED) {
+            removePickup(passengerPool[rider].assignedCar, passengerPool[rider]);
+        }
+        recordBoarding(passengerPool[rider]);
+        boarded += passengerPool[rider].count;
+    }
+
+    hallCalls.removeIf(floor, up, [this](PassengerHandle handle) {
+        return passengerPool[handle].status != PassengerStatus::WAITING;
+    });
+    return boarded;
+}
+
+void ElevatorSystem::scheduleDispatchBatch() {
+    if (batchScheduled) return;
+    batchScheduled = true;
+    events.schedule(currentTime + SimClock::fromSimSeconds(ElevatorConfig::DISPATCH_WINDOW),
+                    EventType::DISPATCH_BATCH);
+}
+
+void ElevatorSystem::assignDestinationBatch() {
+    batchScheduled = false;
+    if (currentStrategy != ElevatorStrategy::DESTINATION_DISPATCH) {
+        unassignedCalls.clear();
+        return;
+    }
+
+    // 仍在候梯的乘客按（出发层，目的层）分组，超过每批上限的留到下一批
+    std::sort(unassignedCalls.begin(), unassignedCalls.end(),
+        [this](const UnassignedCall& a, const UnassignedCall& b) {
+            const Passenger& pa = passengerPool[a.handle];
+            const Passenger& pb = passengerPool[b.handle];
+            if (pa.sourceFloor != pb.sourceFloor) return pa.sourceFloor < pb.sourceFloor;
+            if (pa.targetFloor != pb.targetFloor) return pa.targetFloor < pb.targetFloor;
+            return pa.requestTick < pb.requestTick;
+        });
+
+    batchCalls.clear();
+    callGroups.clear();
+    size_t consumed = 0;
+    for (; consumed < unassignedCalls.size(); ++consumed) {
+        const UnassignedCall& call = unassignedCalls[consumed];
+        const Passenger& passenger = passengerPool[call.handle];
+        if (passenger.serial != call.serial || passenger.status != PassengerStatus::WAITING) continue;
+
+        bool sameGroup = !callGroups.empty() &&
+                         callGroups.back().sourceFloor == passenger.sourceFloor &&
+                         callGroups.back().targetFloor == passenger.targetFloor;
+        if (!sameGroup) {
+            if (static_cast<int>(callGroups.size()) == ElevatorConfig::DISPATCH_BATCH_LIMIT) break;
+            callGroups.push_back(CallGroup{passenger.sourceFloor, passenger.targetFloor, 0, batchCalls.size(), 0});
+        }
+        callGroups.back().count += passenger.count;
+        callGroups.back().callCount++;
+        batchCalls.push_back(call.handle);
+    }
+    unassignedCalls.erase(unassignedCalls.begin(), unassignedCalls.begin() + consumed);
+    if (!unassignedCalls.empty()) {
+        scheduleDispatchBatch();
+    }
+    if (callGroups.empty()) return;
+
+    // 每部电梯提供若干个位置，同一电梯的第 k 个位置多算 k 次开关门，
+    // 装不下的再加一次往返全程，然后求最小总代价的指派
+    const int rows = static_cast<int>(callGroups.size());
+    const int cars = static_cast<int>(elevators.size());
+    const int slots = (rows + cars - 1) / cars;
+    const int cols = cars * slots;
+    const SimTime door = motion.doorTime();
+    const SimTime roundTrip = 2 * motion.travelTime(1, ElevatorConfig::FLOOR_COUNT) +
+                              door * ElevatorConfig::FLOOR_COUNT;
+
+    assignmentCost.assign(static_cast<size_t>(rows) * cols, 0);
+    for (int g = 0; g < rows; ++g) {
+        const CallGroup& group = callGroups[g];
+        const Passenger& representative = passengerPool[batchCalls[group.firstCall]];
+        for (int car = 0; car < cars; ++car) {
+            const auto& elevator = elevators[car];
+            // 与车内乘客或已分配乘客同一目的层的组不增加停靠次数
+            SimTime cost = estimateArrival(car, representative);
+            uint32_t plannedStops = elevator.getStopMask() | pickups[car].targetMask;
+            if ((plannedStops & BitOps::floorBit(group.targetFloor)) == 0) {
+                cost += door;
+            }
+            if (elevator.getCurrentLoad() + pickups[car].total + group.count > ElevatorConfig::MAX_CAPACITY) {
+                cost += roundTrip;
+            }
+            for (int k = 0; k < slots; ++k) {
+                assignmentCost[static_cast<size_t>(g) * cols + car * slots + k] = cost + k * door;
+            }
+        }
+    }
+
+    const std::vector<int>& assignment = assignmentSolver.solve(assignmentCost, rows, cols);
+    for (int g = 0; g < rows; ++g) {
+        int car = assignment[g] / slots;
+        const CallGroup& group = callGroups[g];
+        for (size_t c = 0; c < group.callCount; ++c) {
+            Passenger& passenger = passengerPool[batchCalls[group.firstCall + c]];
+            passenger.assignedCar = static_cast<uint8_t>(car);
+            addPickup(car, passenger);
+        }
+    }
+}
+
+void ElevatorSystem::addPickup(int elevatorIndex, const Passenger& passenger) {
+    auto& calls = pickups[elevatorIndex];
+    markFleetDirty(elevatorIndex);
+    int floor = passenger.sourceFloor;
+    if (passenger.targetFloor > floor) {
+        calls.up[floor - 1] += passenger.count;
+        calls.upMask |= BitOps::floorBit(floor);
+    } else {
+        calls.down[floor - 1] += passenger.count;
+        calls.downMask |= BitOps::floorBit(floor);
+    }
+    calls.targets[passenger.targetFloor - 1] += passenger.count;
+    calls.targetMask |= BitOps::floorBit(passenger.targetFloor);
+    calls.total += passenger.count;
+}
+
+void ElevatorSystem::removePickup(int elevatorIndex, const Passenger& passenger) {
+    auto& calls = pickups[elevatorIndex];
+    markFleetDirty(elevatorIndex);
+    int floor = passenger.sourceFloor;
+    bool up = passenger.targetFloor > floor;
+    uint16_t& waiting = up ? calls.up[floor - 1] : calls.down[floor - 1];
+    waiting -= std::min(passenger.count, waiting);
+    if (waiting == 0) {
+        (up ? calls.upMask : calls.downMask) &= ~BitOps::floorBit(floor);
+    }
+    uint16_t& heading = calls.targets[passenger.targetFloor - 1];
+    heading -= std::min(passenger.count, heading);
+    if (heading == 0) {
+        calls.targetMask &= ~BitOps::floorBit(passenger.targetFloor);
+    }
+    calls.total -= passenger.count;
+}
+
+void ElevatorSystem::dispatchAssignedElevators() {
+    // 空闲电梯开往分配给自己的候梯楼层；空载赶往派梯目标的电梯在途中有新分配时更新目标
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        auto& elevator = elevators[i];
+        int floor = elevator.getCurrentFloor();
+        uint32_t waiting = (pickups[i].upMask | pickups[i].downMask) & ~BitOps::floorBit(floor);
+        if (waiting == 0 || isPriorityResponder(static_cast<int>(i))) continue;
+
+        uint32_t above = waiting & BitOps::maskAbove(floor);
+        uint32_t below = waiting & BitOps::maskBelow(floor);
+        ElevatorState state = elevator.getState();
+        bool goUp;
+        if (state == ElevatorState::IDLE) {
+            if (elevator.getDispatchFloor() > 0) continue;
+            goUp = below == 0 ||
+                (above != 0 && BitOps::lowestFloor(above) - floor <= floor - BitOps::highestFloor(below));
+        } else if (elevator.getDispatchFloor() > 0 && elevator.getCurrentLoad() == 0 &&
+                   state != ElevatorState::STOPPED) {
+            goUp = state == ElevatorState::MOVING_UP;
+            if ((goUp ? above : below) == 0) continue;
+        } else {
+            continue;
+        }
+
+        // 沿途有同向乘客就开到最近的一个，否则开到反向乘客中最远的一层，掉头后顺路接其余乘客
+        int target;
+        if (goUp) {
+            uint32_t sameDirection = pickups[i].upMask & above;
+            target = sameDirection != 0 ? BitOps::lowestFloor(sameDirection) : BitOps::highestFloor(above);
+        } else {
+            uint32_t sameDirection = pickups[i].downMask & below;
+            target = sameDirection != 0 ? BitOps::highestFloor(sameDirection) : BitOps::lowestFloor(below);
+        }
+
+        elevator.setDispatchFloor(target);
+        markFleetDirty(i);
+        if (state == ElevatorState::IDLE) {
+            changeState(i, goUp ? ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN);
+        }
+    }
+}
+
+void ElevatorSystem::resetAssignments() {
+    // 切换策略时撤销所有分配；切换到目的层派梯时把正在候梯的乘客重新排进批处理
+    unassignedCalls.clear();
+    pickups.assign(elevators.size(), PickupCalls());
+    markFleetDirty();
+    uint32_t calls = hallCalls.callMask();
+    while (calls != 0) {
+        int floor = BitOps::lowestFloor(calls);
+        calls &= calls - 1;
+        for (bool up : {true, false}) {
+            for (PassengerHandle handle : hallCalls.queue(floor, up)) {
+                Passenger& passenger = passengerPool[handle];
+                passenger.assignedCar = Passenger::UNASSIGNED;
+                if (currentStrategy == ElevatorStrategy::DESTINATION_DISPATCH &&
+                    passenger.priority == PriorityClass::NORMAL) {
+                    unassignedCalls.push_back(UnassignedCall{handle, passenger.serial});
+                }
+            }
+        }
+    }
+    for (auto& call : priorityCalls) {
+        call.car = -1;
+    }
+    if (!unassignedCalls.empty()) {
+        scheduleDispatchBatch();
+    }
+}
+
+void ElevatorSystem::dispatchIdleElevators() {
+    // 已有电梯停在该层或正在前往的召唤不再重复派梯
+    refreshFleet();
+    const CarFloorIndex& index = fleet.index();
+    uint32_t covered = index.targetFloors() |
+        index.floors(CarFloorIndex::IDLE) | index.floors(CarFloorIndex::STOPPED);
+
+    uint32_t pending = hallCalls.callMask() & ~covered;
+    while (pending != 0) {
+        int floor = BitOps::lowestFloor(pending);
+        pending &= pending - 1;
+
+        bool up = hallCalls.hasCall(floor, true);
+        int index = findBestElevator(passengerPool[hallCalls.front(floor, up)]);
+        if (index < 0) continue;
+
+        // 选中运行中的电梯时不改变其计划，它顺路经过时会停靠接客
+        auto& elevator = elevators[index];
+        if (elevator.getState() != ElevatorState::IDLE) continue;
+
+        elevator.setDispatchFloor(floor);
+        changeState(index, floor > elevator.getCurrentFloor() ?
+            ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN);
+    }
+}
+
+void ElevatorSystem::enqueueCall(PassengerHandle handle) {
+    // 普通召唤排在队尾；优先召唤排在同类及更优先的乘客之后、其余乘客之前
+    const Passenger& passenger = passengerPool[handle];
+    int floor = passenger.sourceFloor;
+    bool up = passenger.targetFloor > floor;
+    if (passenger.priority == PriorityClass::NORMAL) {
+        hallCalls.push(handle, floor, up);
+        return;
+    }
+
+    PassengerHandle before = HallCallQueues::NONE;
+    for (PassengerHandle queued : hallCalls.queue(floor, up)) {
+        if (passengerPool[queued].priority > passenger.priority) {
+            before = queued;
+            break;
+        }
+    }
+    hallCalls.insertBefore(handle, floor, up, before);
+}
+
+void ElevatorSystem::recordBoarding(Passenger& passenger) {
+    SimTime waited = currentTime - passenger.requestTime();
+    int priority = static_cast<int>(passenger.priority);
+    classWaits[priority].record(Passenger::clampTicks(waited), passenger.count);
+    if (waited <= waitTarget(passenger.priority)) {
+        classWithinTarget[priority] += passenger.count;
+    }
+    totalWaitTime += SimClock::toSimSeconds(waited) * passenger.count;
+    journeyLatency.recordBoarding(passenger, currentTime);
+    passenger.boardTick = Passenger::clampTicks(currentTime);
+}
+
+bool ElevatorSystem::isPriorityResponder(int elevatorIndex) const {
+    for (const auto& call : priorityCalls) {
+        if (call.car == elevatorIndex) return true;
+    }
+    return false;
+}
+
+SimTime ElevatorSystem::directArrival(int elevatorIndex, int floor) const {
+    // 放弃原计划直接开往 floor：运行中的电梯先到下一个停靠点，开门中的先关门
+    const auto& elevator = elevators[elevatorIndex];
+    int from = elevator.getCurrentFloor();
+    SimTime start = currentTime;
+    switch (elevator.getState()) {
+        case ElevatorState::MOVING_UP:
+        case ElevatorState::MOVING_DOWN:
+            from = motion.isKinematic() ? runs[elevatorIndex].targetFloor
+                : std::min(std::max(from + elevator.getDirection(), 1), ElevatorConfig::FLOOR_COUNT);
+            start = carTimers.expiry(elevatorIndex);
+            break;
+        case ElevatorState::STOPPED:
+            start = carTimers.expiry(elevatorIndex);
+            break;
+        case ElevatorState::IDLE:
+            break;
+    }
+    return start - currentTime + motion.travelTime(from, floor);
+}
+
+void ElevatorSystem::dispatchPriorityCalls() {
+    // 已上车或已超时的优先召唤出列
+    priorityCalls.erase(std::remove_if(priorityCalls.begin(), priorityCalls.end(), [this](const PriorityCall& call) {
+        const Passenger& passenger = passengerPool[call.handle];
+        return passenger.serial != call.serial || passenger.status != PassengerStatus::WAITING;
+    }), priorityCalls.end());
+    if (priorityCalls.empty()) return;
+
+    refreshFleet();
+    bool destination = currentStrategy == ElevatorStrategy::DESTINATION_DISPATCH;
+    for (auto& call : priorityCalls) {
+        Passenger& passenger = passengerPool[call.handle];
+        int floor = passenger.sourceFloor;
+        bool up = passenger.targetFloor > floor;
+        if (call.car >= 0 && elevators[call.car].getDispatchFloor() == floor) continue;
+        if (destination && passenger.assignedCar != Passenger::UNASSIGNED) continue;
+        call.car = -1;
+
+        // 载客电梯按现有计划顺路到达，空载电梯可以放弃原计划直接开过来
+        int passing = -1;
+        int preempt = -1;
+        SimTime passingEta = SimClock::NEVER;
+        SimTime preemptEta = SimClock::NEVER;
+        for (int i = 0; i < static_cast<int>(elevators.size()); ++i) {
+            const auto& elevator = elevators[i];
+            if (elevator.getCurrentLoad() >= ElevatorConfig::MAX_CAPACITY) continue;
+            if (elevator.getCurrentLoad() == 0 && elevator.getStopMask() == 0) {
+                if (isPriorityResponder(i)) continue;
+                SimTime eta = directArrival(i, floor);
+                if (eta < preemptEta) {
+                    preemptEta = eta;
+                    preempt = i;
+                }
+            } else {
+                SimTime eta = fleet.eta(i, floor, up, currentTime);
+                if (eta < passingEta) {
+                    passingEta = eta;
+                    passing = i;
+                }
+            }
+        }
+
+        // 顺路电梯能在本类时限目标内赶到，或比改派还快，就不打乱其他电梯的计划
+        SimTime remaining = passenger.requestTime() + waitTarget(passenger.priority) - currentTime;
+        bool usePassing = passing >= 0 && (passingEta <= remaining || passingEta <= preemptEta);
+        int car = usePassing ? passing : preempt;
+        if (car < 0) continue;
+        if (destination) {
+            passenger.assignedCar = static_cast<uint8_t>(car);
+            addPickup(car, passenger);
+        }
+
+        auto& elevator = elevators[car];
+        if (usePassing || (elevator.getCurrentFloor() == floor && elevator.getState() == ElevatorState::IDLE)) continue;
+
+        // 改派空载电梯，它原来的派梯目标之后由其他电梯补上
+        call.car = car;
+        elevator.setDispatchFloor(floor);
+        markFleetDirty(car);
+        if (elevator.getState() == ElevatorState::IDLE) {
+            changeState(car, floor > elevator.getCurrentFloor() ? ElevatorState::MOVING_UP : ElevatorState::MOVING_DOWN);
+        }
+    }
+}
+
+SimTime ElevatorSystem::waitTarget(PriorityClass priority) {
+    switch (priority) {
+        case PriorityClass::EMERGENCY:
+            return SimClock::fromSimSeconds(ElevatorConfig::EMERGENCY_WAIT_TARGET);
+        case PriorityClass::ACCESSIBILITY:
+            return SimClock::fromSimSeconds(ElevatorConfig::ACCESSIBILITY_WAIT_TARGET);
+        case PriorityClass::NORMAL:
+        default:
+            return SimClock::fromSimSeconds(ElevatorConfig::MAX_WAIT_TIME);
+    }
+}
+
+const char* ElevatorSystem::priorityName(PriorityClass priority) {
+    switch (priority) {
+        case PriorityClass::EMERGENCY: return "紧急";
+        case PriorityClass::ACCESSIBILITY: return "无障碍";
+        case PriorityClass::NORMAL: return "普通";
+    }
+    return "普通";
+}
+
+void ElevatorSystem::generatePeakTimeRequests(double startHour, double endHour, bool isUpPeak, std::mt19937& gen) {
+    double timeRange = (endHour - startHour) * 3600;
+    std::uniform_real_distribution<> timeDist(0, timeRange);
+    std::uniform_int_distribution<> floorDist(2, ElevatorConfig::FLOOR_COUNT);
+    std::uniform_int_distribution<> countDist(1, 4);
+
+    for (int i = 0; i < requestConfig.peakTimeRequests; ++i) {
+        double relativeTime = timeDist(gen);
+        double time = startHour + (relativeTime / 3600.0);
+        
+        int count = countDist(gen);
+        
+        if (isUpPeak) {
+            int targetFloor = floorDist(gen);
+            addManualRequest(1, targetFloor, count, time, randomPriority());
+        } else {
+            int sourceFloor = floorDist(gen);
+            addManualRequest(sourceFloor, 1, count, time, randomPriority());
+        }
+    }
+}
+
+void ElevatorSystem::generateNormalTimeRequests(std::mt19937& gen) {
+    std::vector<std::pair<double, double>> normalHours = {
+        {0.0, 6.0},    // 凌晨
+        {8.0, 11.0},   // 上午
+        {12.0, 13.0},  // 中午
+        {14.0, 17.0},  // 下午
+        {18.0, 24.0}   // 晚上
+    };
+    
+    std::uniform_int_distribution<> floorDist(1, ElevatorConfig::FLOOR_COUNT);
+    std::uniform_int_distribution<> countDist(1, 3);
+    
+    for (int i = 0; i < requestConfig.normalTimeRequests; ++i) {
+        int periodIndex = std::uniform_int_distribution<>(0, normalHours.size() - 1)(gen);
+        auto period = normalHours[periodIndex];
+        
+        double time = std::uniform_real_distribution<>(period.first, period.second)(gen);
+        
+        int sourceFloor = floorDist(gen);
+        int targetFloor;
+        do {
+            targetFloor = floorDist(gen);
+        } while (targetFloor == sourceFloor);
+        
+        int count = countDist(gen);
+        addManualRequest(sourceFloor, targetFloor, count, time, randomPriority());
+    }
+}
+
+int ElevatorSystem::findBestElevator(const Passenger& passenger) const {
+    switch (currentStrategy) {
+        case ElevatorStrategy::NEAREST_FIRST:
+            return findNearestElevator(passenger);
+        case ElevatorStrategy::SCAN:
+            return findScanElevator(passenger);
+        case ElevatorStrategy::LOOK:
+            return findLookElevator(passenger);
+        case ElevatorStrategy::ROLLOUT:
+            return findRolloutElevator(passenger);
+        case ElevatorStrategy::DESTINATION_DISPATCH:
+        default:
+            return findNearestElevator(passenger);
+    }
+}
+
+int ElevatorSystem::findNearestElevator(const Passenger& passenger) const {
+    refreshFleet();
+    return fleet.bestCar(passenger, ElevatorFleet::Filter::AVAILABLE, currentTime, motion);
+}
+
+int ElevatorSystem::findScanElevator(const Passenger& passenger) const {
+    // 只在朝乘客目的层方向运行的电梯中选，没有时退回就近优先
+    refreshFleet();
+    int bestIndex = fleet.bestCar(passenger, ElevatorFleet::Filter::MOVING_TOWARD_TARGET, currentTime, motion);
+    return bestIndex >= 0 ? bestIndex : findNearestElevator(passenger);
+}
+
+int ElevatorSystem::findLookElevator(const Passenger& passenger) const {
+    // 只在还没驶过乘客所在楼层的同向运行电梯中选，没有时退回就近优先
+    refreshFleet();
+    int bestIndex = fleet.bestCar(passenger, ElevatorFleet::Filter::MOVING_TOWARD_SOURCE, currentTime, motion);
+    return bestIndex >= 0 ? bestIndex : findNearestElevator(passenger);
+}
+
+int ElevatorSystem::findRolloutElevator(const Passenger& passenger) const {
+    // 每部空闲电梯是一个方案，另加一个“交给下一部顺路经过的运行中电梯”的方案
+    refreshFleet();
+    const CarFloorIndex& index = fleet.index();
+    rolloutActions.clear();
+    uint32_t idleFloors = index.floors(CarFloorIndex::IDLE);
+    while (idleFloors != 0) {
+        int floor = BitOps::lowestFloor(idleFloors);
+        idleFloors &= idleFloors - 1;
+        index.forEachCar(CarFloorIndex::IDLE, floor, [&](int car) {
+            if (elevators[car].getCurrentLoad() < ElevatorConfig::MAX_CAPACITY) {
+                rolloutActions.push_back(RolloutPlanner::Action{car, passenger.sourceFloor});
+            }
+        });
+    }
+    std::sort(rolloutActions.begin(), rolloutActions.end(),
+        [](const RolloutPlanner::Action& a, const RolloutPlanner::Action& b) { return a.car < b.car; });
+
+    int passingIndex = index.nextPassing(passenger.sourceFloor, passenger.targetFloor > passenger.sourceFloor);
+    if (passingIndex >= 0 && elevators[passingIndex].getCurrentLoad() >= ElevatorConfig::MAX_CAPACITY) {
+        passingIndex = -1;
+    }
+    if (passingIndex >= 0) {
+        rolloutActions.push_back(RolloutPlanner::Action{-1, passenger.sourceFloor});
+    }
+    if (rolloutActions.empty()) {
+        return findNearestElevator(passenger);
+    }
+
+    int best = 0;
+    if (rolloutActions.size() > 1) {
+        captureRolloutSnapshot();
+        best = rolloutPlanner.choose(rolloutSnapshot, rolloutActions, motion);
+        if (best < 0) {
+            // 预算内没有算完任何方案，退回按预计到达时间选梯
+            return findNearestElevator(passenger);
+        }
+    }
+    return rolloutActions[best].car >= 0 ? rolloutActions[best].car : passingIndex;
+}
+
+void ElevatorSystem::captureRolloutSnapshot() const {
+    auto& snapshot = rolloutSnapshot;
+    auto& start = snapshot.start;
+    snapshot.now = currentTime;
+    snapshot.horizon = currentTime + (ElevatorConfig::ROLLOUT_HORIZON > 0 ?
+        SimClock::fromSimSeconds(ElevatorConfig::ROLLOUT_HORIZON) :
+        2 * motion.travelTime(1, ElevatorConfig::FLOOR_COUNT) + motion.doorTime() * ElevatorConfig::FLOOR_COUNT);
+    snapshot.cars = static_cast<int>(elevators.size());
+
+    // 运行中的电梯从下一次到站开始模拟，开门中的从关门时刻开始
+    for (size_t i = 0; i < elevators.size(); ++i) {
+        const auto& elevator = elevators[i];
+        int floor = elevator.getCurrentFloor();
+        int direction = elevator.getDirection();
+        start.stops[i] = elevator.getStopMask();
+        start.alight[i].fill(0);
+        for (const auto& rider : elevator.getPassengers()) {
+            start.alight[i][rider.targetFloor - 1] += rider.count;
+        }
+        start.target[i] = static_cast<int8_t>(elevator.getDispatchFloor());
+        start.load[i] = static_cast<uint8_t>(elevator.getCurrentLoad());
+
+        switch (elevator.getState()) {
+            case ElevatorState::IDLE:
+                start.readyAt[i] = currentTime;
+                start.phase[i] = RolloutPlanner::DEPART;
+                direction = 0;
+                break;
+            case ElevatorState::STOPPED:
+                start.readyAt[i] = carTimers.expiry(i);
+                start.phase[i] = RolloutPlanner::DEPART;
+                break;
+            case ElevatorState::MOVING_UP:
+            case ElevatorState::MOVING_DOWN:
+                floor = motion.isKinematic() ? runs[i].targetFloor
+                                             : std::min(std::max(floor + direction, 1), ElevatorConfig::FLOOR_COUNT);
+                start.readyAt[i] = carTimers.expiry(i);
+                start.phase[i] = RolloutPlanner::ARRIVE;
+                break;
+        }
+        start.floor[i] = static_cast<int8_t>(floor);
+        start.direction[i] = static_cast<int8_t>(direction);
+    }
+
+    start.head.fill(0);
+    start.headTaken.fill(0);
+    start.upCalls = hallCalls.upCallMask();
+    start.downCalls = hallCalls.downCallMask();
+    start.claimed = 0;
+    for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
+        for (bool up : {true, false}) {
+            int q = RolloutPlanner::queueIndex(floor, up);
+            int length = 0;
+            for (PassengerHandle handle : hallCalls.queue(floor, up)) {
+                if (length == RolloutPlanner::QUEUE_DEPTH) break;
+                const Passenger& passenger = passengerPool[handle];
+                snapshot.calls[q][length++] = RolloutPlanner::CallGroup{
+                    passenger.requestTime(), passenger.deadline(), passenger.count, passenger.targetFloor};
+            }
+            snapshot.queueLength[q] = static_cast<uint8_t>(length);
+        }
+    }
+}
+
+void ElevatorSystem::setElevatorSpeed(double speed) {
+    ElevatorConfig::setFloorTime(speed);
+    rebuildMotion();
+}
+
+void ElevatorSystem::setMaxWaitTime(double time) {
+    ElevatorConfig::setMaxWaitTime(time);
+}
+
+void ElevatorSystem::setMaxIdleTime(double time) {
+    ElevatorConfig::setIdleMaxTime(time);
+}
+
+void ElevatorSystem::setRequestCounts(int peakCount, int normalCount) {
+    if (peakCount > 0) requestConfig.peakTimeRequests = peakCount;
+    if (normalCount > 0) requestConfig.normalTimeRequests = normalCount;
+}
+
+ElevatorStrategy ElevatorSystem::strategyFor(TrafficMode mode) {
+    // 上行高峰按目的层成批派梯，下行高峰用 LOOK 沿途收齐各层乘客，其余情况就近响应
+    switch (mode) {
+        case TrafficMode::UP_PEAK:
+            return ElevatorStrategy::DESTINATION_DISPATCH;
+        case TrafficMode::DOWN_PEAK:
+            return ElevatorStrategy::LOOK;
+        default:
+            return ElevatorStrategy::NEAREST_FIRST;
+    }
+}
+
+void ElevatorSystem::applyTrafficMode(TrafficMode mode) {
+    ElevatorStrategy strategy = strategyFor(mode);
+    if (strategy == currentStrategy) return;
+
+    Logger::log(std::string("客流模式：") + TrafficClassifier::name(mode));
+    setStrategy(strategy);
+    strategySwitches++;
+}
+
+void ElevatorSystem::setStrategy(ElevatorStrategy strategy) {
+    bool changed = strategy != currentStrategy;
+    currentStrategy = strategy;
+    if (changed) {
+        resetAssignments();
+    }
+    
+    std::string strategyName;
+    switch (strategy) {
+        case ElevatorStrategy::NEAREST_FIRST:
+            strategyName = "就近优先";
+            break;
+        case ElevatorStrategy::SCAN:
+            strategyName = "扫描算法";
+            break;
+        case ElevatorStrategy::LOOK:
+            strategyName = "LOOK算法";
+            break;
+        case ElevatorStrategy::DESTINATION_DISPATCH:
+            strategyName = "目的层派梯";
+            break;
+        case ElevatorStrategy::ROLLOUT:
+            strategyName = "前瞻模拟派梯";
+            break;
+    }
+    Logger::log("电梯策略已更改为: " + strategyName);
+}
  
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "EtaProfile.h"
+#include "BitOps.h"
+#include <algorithm>
+
+bool EtaProfile::update(int floor, int dir, uint32_t stops, bool stopsAtAnchor, const MotionModel& motion) {
+    stops &= ~BitOps::floorBit(floor);
+    if (floor == anchorFloor && dir == direction && stops == stopMask && stopsAtAnchor == anchorStop) {
+        return false;
+    }
+    anchorFloor = floor;
+    direction = dir;
+    stopMask = stops;
+    anchorStop = stopsAtAnchor;
+    rebuild(motion);
+    return true;
+}
+
+void EtaProfile::rebuild(const MotionModel& motion) {
+    const int floors = ElevatorConfig::FLOOR_COUNT;
+    const SimTime door = motion.doorTime();
+    const SimTime base = anchorStop ? door : 0;
+
+    if (direction == 0) {
+        for (int f = 1; f <= floors; ++f) {
+            SimTime eta = f == anchorFloor ? 0 : base + motion.travelTime(anchorFloor, f);
+            upOffsets[f - 1] = downOffsets[f - 1] = eta;
+        }
+        return;
+    }
+
+    // 下行时把楼层翻转成上行处理：o 为沿运行方向的序号，a 为锚点的序号
+    auto toFloor = [&](int o) { return direction > 0 ? o : floors + 1 - o; };
+    const int a = direction > 0 ? anchorFloor : floors + 1 - anchorFloor;
+
+    std::array<int, ElevatorConfig::FLOOR_COUNT + 1> stopsUpTo{};  // 序号 1..o 中的停靠层数
+    int top = a;
+    int bottom = a;
+    for (int o = 1; o <= floors; ++o) {
+        bool stop = (stopMask & BitOps::floorBit(toFloor(o))) != 0;
+        stopsUpTo[o] = stopsUpTo[o - 1] + (stop ? 1 : 0);
+        if (stop && o > a) top = o;
+        if (stop && o < a && bottom == a) bottom = o;
+    }
+    auto stopsBetween = [&](int low, int high) {  // 开区间 (low, high) 内的停靠层数
+        return high - low > 1 ? stopsUpTo[high - 1] - stopsUpTo[low] : 0;
+    };
+    auto travel = [&](int from, int to) { return motion.travelTime(from, to); };
+
+    // 开到最远停靠层并在那里开门所需时间
+    SimTime toTop = base + travel(a, top) + door * (stopsBetween(a, top) + (top > a ? 1 : 0));
+
+    for (int o = 1; o <= floors; ++o) {
+        SimTime ahead;   // 同向召唤
+        SimTime behind;  // 反向召唤
+        if (o == a) {
+            ahead = 0;
+        } else if (o > a) {
+            ahead = base + travel(a, o) + door * stopsBetween(a, o);
+        } else {
+            // 在身后：到顶掉头，服务完下方停靠层到最低点后再折返
+            int low = std::min(o, bottom);
+            int stopsOnWay = low == o ? stopsBetween(o, a) : stopsBetween(low - 1, a);
+            ahead = toTop + travel(top, low) + door * stopsOnWay + travel(low, o);
+        }
+
+        if (o >= top) {
+            behind = o == a ? 0 : base + travel(a, o) + door * stopsBetween(a, o);
+        } else {
+            behind = toTop + travel(top, o) + door * stopsBetween(o, a);
+        }
+
+        int f = toFloor(o);
+        bool aheadIsUp = direction > 0;
+        (aheadIsUp ? upOffsets : downOffsets)[f - 1] = ahead;
+        (aheadIsUp ? downOffsets : upOffsets)[f - 1] = behind;
+    }
+}
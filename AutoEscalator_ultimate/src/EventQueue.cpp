@@ -0,0 +1,16 @@
+#include "EventQueue.h"
+
+void EventQueue::schedule(SimTime time, EventType type) {
+    events.push(SimEvent{time, type, nextSequence++});
+}
+
+SimEvent EventQueue::pop() {
+    SimEvent event = events.top();
+    events.pop();
+    return event;
+}
+
+void EventQueue::clear() {
+    events = decltype(events)();
+    nextSequence = 0;
+}
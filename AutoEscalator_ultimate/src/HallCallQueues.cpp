@@ -0,0 +1,50 @@
+#include "HallCallQueues.h"
+#include "BitOps.h"
+
+void HallCallQueues::link(PassengerHandle handle, int floor, bool up, PassengerHandle before) {
+    if (handle >= links.size()) {
+        links.resize(static_cast<size_t>(handle) + 1);
+    }
+    int index = queueIndex(floor, up);
+    Queue& queue = queues[index];
+    Link& entry = links[handle];
+    entry.queue = static_cast<int16_t>(index);
+    entry.next = before;
+    entry.prev = before == NONE ? queue.tail : links[before].prev;
+    (entry.prev == NONE ? queue.head : links[entry.prev].next) = handle;
+    (before == NONE ? queue.tail : links[before].prev) = handle;
+    queue.people += pool[handle].count;
+    (up ? upCalls : downCalls) |= BitOps::floorBit(floor);
+    waitingCount++;
+}
+
+void HallCallQueues::unlink(PassengerHandle handle, int floor, bool up) {
+    Queue& queue = queues[queueIndex(floor, up)];
+    Link& entry = links[handle];
+    (entry.prev == NONE ? queue.head : links[entry.prev].next) = entry.next;
+    (entry.next == NONE ? queue.tail : links[entry.next].prev) = entry.prev;
+    entry = Link();
+    queue.people -= pool[handle].count;
+    waitingCount--;
+    if (queue.head == NONE) {
+        (up ? upCalls : downCalls) &= ~BitOps::floorBit(floor);
+    }
+}
+
+bool HallCallQueues::remove(int floor, bool up, PassengerHandle handle) {
+    if (handle >= links.size() || links[handle].queue != queueIndex(floor, up)) return false;
+    unlink(handle, floor, up);
+    return true;
+}
+
+void HallCallQueues::clear() {
+    queues.fill(Queue());
+    links.clear();
+    upCalls = 0;
+    downCalls = 0;
+    waitingCount = 0;
+}
+
+bool HallCallQueues::hasCall(int floor, bool up) const {
+    return ((up ? upCalls : downCalls) & BitOps::floorBit(floor)) != 0;
+}
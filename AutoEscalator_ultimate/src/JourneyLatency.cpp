@@ -0,0 +1,43 @@
+#include "JourneyLatency.h"
+
+JourneyLatency::JourneyLatency()
+    : histograms(static_cast<size_t>(METRIC_COUNT) * SLOTS) {
+}
+
+void JourneyLatency::clear() {
+    for (auto& histogram : histograms) {
+        histogram.clear();
+    }
+}
+
+void JourneyLatency::merge(const JourneyLatency& other) {
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        histograms[i].merge(other.histograms[i]);
+    }
+}
+
+void JourneyLatency::record(Metric metric, const Passenger& passenger, SimTime ticks) {
+    uint32_t value = Passenger::clampTicks(ticks);
+    bool up = passenger.targetFloor > passenger.sourceFloor;
+    at(metric, 0).record(value, passenger.count);
+    at(metric, floorSlot(passenger.sourceFloor, up)).record(value, passenger.count);
+    at(metric, hourSlot(passenger.requestTime())).record(value, passenger.count);
+}
+
+void JourneyLatency::recordBoarding(const Passenger& passenger, SimTime now) {
+    record(WAIT, passenger, now - passenger.requestTime());
+}
+
+void JourneyLatency::recordArrival(const Passenger& passenger, SimTime boardTime, SimTime now) {
+    record(RIDE, passenger, now - boardTime);
+    record(JOURNEY, passenger, now - passenger.requestTime());
+}
+
+const char* JourneyLatency::metricName(Metric metric) {
+    switch (metric) {
+        case WAIT: return "候梯";
+        case RIDE: return "乘梯";
+        case JOURNEY: return "全程";
+        default: return "";
+    }
+}
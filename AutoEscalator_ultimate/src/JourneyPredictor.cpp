@@ -0,0 +1,63 @@
+#include "JourneyPredictor.h"
+#include "BitOps.h"
+#include "Passenger.h"
+#include <atomic>
+
+std::shared_ptr<JourneyPredictor::Snapshot> JourneyPredictor::acquire() {
+    // 引用计数为 1 说明只剩池里这一份：既不是当前快照，也没有查询线程还在读。
+    // 查询线程释放引用时的递减带有 release 语义，这里配一个 acquire 栅栏后再覆盖
+    for (const auto& snapshot : pool) {
+        if (snapshot.use_count() == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return snapshot;
+        }
+    }
+    pool.push_back(std::make_shared<Snapshot>());
+    return pool.back();
+}
+
+void JourneyPredictor::publish(std::shared_ptr<const Snapshot> snapshot) {
+    std::atomic_store_explicit(&current, std::move(snapshot), std::memory_order_release);
+}
+
+bool JourneyPredictor::ready() const {
+    return std::atomic_load_explicit(&current, std::memory_order_acquire) != nullptr;
+}
+
+JourneyPrediction JourneyPredictor::predict(int from, int to, SimTime time) const {
+    JourneyPrediction result;
+    std::shared_ptr<const Snapshot> snapshot = std::atomic_load_explicit(&current, std::memory_order_acquire);
+    if (!snapshot || from == to || from < 1 || to < 1 ||
+        from > ElevatorConfig::FLOOR_COUNT || to > ElevatorConfig::FLOOR_COUNT) {
+        return result;
+    }
+
+    const ElevatorFleet& fleet = snapshot->fleet;
+    const MotionModel& motion = *snapshot->motion;
+    SimTime now = time > snapshot->time ? time : snapshot->time;
+    Passenger passenger(from, to, now, 0);
+    int car = fleet.bestCar(passenger, snapshot->filter, now, motion);
+    if (car < 0 && snapshot->fallback) {
+        car = fleet.bestCar(passenger, ElevatorFleet::Filter::AVAILABLE, now, motion);
+    }
+    if (car < 0) return result;
+
+    // 上车后沿途在电梯已登记的停靠层各停一次，每段按静止出发、静止到达计运行时间
+    const bool up = to > from;
+    uint32_t stops = fleet.stops(car) & BitOps::maskAbove(up ? from : to) & BitOps::maskBelow(up ? to : from);
+    SimTime ride = motion.doorTime();
+    int floor = from;
+    while (stops != 0) {
+        int next = up ? BitOps::lowestFloor(stops) : BitOps::highestFloor(stops);
+        stops &= ~BitOps::floorBit(next);
+        ride += motion.travelTime(floor, next) + motion.doorTime();
+        floor = next;
+    }
+    ride += motion.travelTime(floor, to);
+
+    result.car = car;
+    result.time = SimClock::toSimSeconds(now);
+    result.waitTime = SimClock::toSimSeconds(fleet.eta(car, from, up, now));
+    result.rideTime = SimClock::toSimSeconds(ride);
+    return result;
+}
@@ -0,0 +1,36 @@
+#include "LatencyHistogram.h"
+#include <cmath>
+#include <algorithm>
+
+uint32_t LatencyHistogram::bucketHighest(int bucket) {
+    if (bucket < 2 * SUB_BUCKETS) return static_cast<uint32_t>(bucket);
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t sub = static_cast<uint64_t>(bucket - shift * SUB_BUCKETS);
+    return static_cast<uint32_t>(((sub + 1) << shift) - 1);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+void LatencyHistogram::clear() {
+    counts.fill(0);
+    total = 0;
+    maxValue = 0;
+}
+
+uint32_t LatencyHistogram::percentile(double fraction) const {
+    if (total == 0) return 0;
+    // 累计计数首次达到 fraction 比例的桶
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * total)));
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(bucketHighest(i), maxValue);
+    }
+    return maxValue;
+}
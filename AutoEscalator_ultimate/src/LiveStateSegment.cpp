@@ -0,0 +1,136 @@
+#include "LiveStateSegment.h"
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LIVE_STATE_POSIX_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::string segmentPath(const std::string& segmentName) {
+    return !segmentName.empty() && segmentName[0] == '/' ? segmentName : "/" + segmentName;
+}
+
+}
+
+LiveStateSegment::~LiveStateSegment() {
+    close();
+}
+
+bool LiveStateSegment::create(const std::string& segmentName) {
+    close();
+#ifdef LIVE_STATE_POSIX_SHM
+    std::string path = segmentPath(segmentName);
+    // 只创建新段：同名段可能属于另一个正在运行的仿真，接管它会让两个写者互相覆盖
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        if (errno == EEXIST) {
+            std::cerr << "共享内存段 " << path << " 已存在：可能有另一个仿真正在使用该名称，"
+                      << "或上次运行异常退出后留下了旧段。确认无人使用后删除它（Linux 下为 /dev/shm"
+                      << path << "）再重试" << std::endl;
+        } else {
+            std::cerr << "无法创建共享内存段 " << path << ": " << std::strerror(errno) << std::endl;
+        }
+        return false;
+    }
+    if (ftruncate(fd, sizeof(LiveStateLayout)) != 0) {
+        ::close(fd);
+        shm_unlink(path.c_str());
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(LiveStateLayout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(path.c_str());
+        return false;
+    }
+
+    // 监控程序可能在头部写完之前就映射了新段，先把计数置为奇数再写头部
+    layout = new (memory) LiveStateLayout;
+    layout->sequence.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    layout->magic = LiveStateLayout::MAGIC;
+    layout->version = LiveStateLayout::VERSION;
+    layout->floorCount = ElevatorConfig::FLOOR_COUNT;
+    layout->maxCars = ElevatorConfig::MAX_ELEVATOR_COUNT;
+    std::memset(&layout->data, 0, sizeof(layout->data));
+    layout->sequence.store(2, std::memory_order_release);
+    name = path;
+    owner = true;
+    return true;
+#else
+    (void)segmentName;
+    return false;
+#endif
+}
+
+bool LiveStateSegment::attach(const std::string& segmentName) {
+    close();
+#ifdef LIVE_STATE_POSIX_SHM
+    std::string path = segmentPath(segmentName);
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(LiveStateLayout)) {
+        ::close(fd);
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(LiveStateLayout), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) return false;
+
+    layout = static_cast<LiveStateLayout*>(memory);
+    if (layout->magic != LiveStateLayout::MAGIC || layout->version != LiveStateLayout::VERSION ||
+        layout->floorCount != static_cast<uint32_t>(ElevatorConfig::FLOOR_COUNT) ||
+        layout->maxCars != static_cast<uint32_t>(ElevatorConfig::MAX_ELEVATOR_COUNT)) {
+        close();
+        return false;
+    }
+    name = path;
+    owner = false;
+    return true;
+#else
+    (void)segmentName;
+    return false;
+#endif
+}
+
+void LiveStateSegment::close() {
+#ifdef LIVE_STATE_POSIX_SHM
+    if (layout) {
+        munmap(layout, sizeof(LiveStateLayout));
+        if (owner) shm_unlink(name.c_str());
+    }
+#endif
+    layout = nullptr;
+    owner = false;
+    name.clear();
+}
+
+void LiveStateSegment::publish(const LiveStateData& data) {
+    if (!layout || !owner) return;
+    uint64_t sequence = layout->sequence.load(std::memory_order_relaxed);
+    layout->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&layout->data, &data, sizeof(data));
+    layout->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool LiveStateSegment::read(LiveStateData& out, int maxRetries) const {
+    if (!layout) return false;
+    for (int attempt = 0; attempt < maxRetries; ++attempt) {
+        uint64_t before = layout->sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        std::memcpy(&out, &layout->data, sizeof(out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (layout->sequence.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
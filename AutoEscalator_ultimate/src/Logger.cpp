@@ -1,4 +1,4 @@
-#include "Logger.h"
-
-std::ofstream Logger::logFile;
+#include "Logger.h"
+
+std::ofstream Logger::logFile;
 bool Logger::initialized = false; 
\ No newline at end of file
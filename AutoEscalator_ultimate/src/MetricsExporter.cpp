@@ -0,0 +1,163 @@
+#include "MetricsExporter.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <utility>
+
+namespace {
+
+const char* stateLabel(ElevatorState state) {
+    switch (state) {
+        case ElevatorState::IDLE: return "idle";
+        case ElevatorState::MOVING_UP: return "moving_up";
+        case ElevatorState::MOVING_DOWN: return "moving_down";
+        case ElevatorState::STOPPED: return "stopped";
+    }
+    return "idle";
+}
+
+void writeHeader(std::ostream& out, const char* name, const char* type, const char* help) {
+    out << "# TYPE " << name << ' ' << type << "\n# HELP " << name << ' ' << help << '\n';
+}
+
+}
+
+MetricsExporter::MetricsExporter(std::string filename, double intervalSeconds)
+    : path(std::move(filename))
+    , interval(std::max<long long>(1, static_cast<long long>(intervalSeconds * 1000)))
+    , nextCapture(std::chrono::steady_clock::now())
+{
+    writer = std::thread(&MetricsExporter::run, this);
+}
+
+MetricsExporter::~MetricsExporter() {
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join();
+    }
+}
+
+void MetricsExporter::swapIn() {
+    if (!hasOrigin) {
+        hasOrigin = true;
+        originSeconds = staged.simulatedSeconds;
+        originWall = staged.wallTime;
+    }
+    std::swap(staged, pending);
+    hasPending = true;
+}
+
+void MetricsExporter::submit() {
+    staged.wallTime = std::chrono::steady_clock::now();
+    nextCapture = staged.wallTime + interval / 4;
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+    swapIn();
+}
+
+bool MetricsExporter::stop() {
+    if (!writer.joinable()) return !failed;
+    staged.wallTime = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        swapIn();
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+    return !failed;
+}
+
+void MetricsExporter::run() {
+    MetricsSnapshot writing;
+    double lastSeconds = 0.0;
+    std::chrono::steady_clock::time_point lastWall;
+    bool started = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait_for(lock, interval, [this]() { return stopping; });
+        bool last = stopping;
+        bool fresh = hasPending;
+        if (fresh) {
+            std::swap(pending, writing);
+            hasPending = false;
+            if (!started) {
+                started = true;
+                lastSeconds = originSeconds;
+                lastWall = originWall;
+            }
+        }
+        lock.unlock();
+
+        // 运行速度按相邻两次写入之间的模拟时间和墙钟时间计算
+        if (fresh) {
+            double wall = std::chrono::duration<double>(writing.wallTime - lastWall).count();
+            double speed = wall > 0 ? (writing.simulatedSeconds - lastSeconds) / wall : 0.0;
+            bool ok = write(writing, speed);
+            lastSeconds = writing.simulatedSeconds;
+            lastWall = writing.wallTime;
+            lock.lock();
+            failed = failed || !ok;
+        } else {
+            lock.lock();
+        }
+        if (last) break;
+    }
+}
+
+bool MetricsExporter::write(const MetricsSnapshot& snapshot, double speed) const {
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::trunc);
+        if (!out.is_open()) return false;
+        out << std::fixed << std::setprecision(6);
+
+        writeHeader(out, "elevator_requests", "counter", "已载入的请求人数");
+        out << "elevator_requests_total " << snapshot.requests << '\n';
+        writeHeader(out, "elevator_boarded", "counter", "已上车的乘客人数");
+        out << "elevator_boarded_total " << snapshot.boarded << '\n';
+        writeHeader(out, "elevator_timeouts", "counter", "等待超时放弃的乘客人数");
+        out << "elevator_timeouts_total " << snapshot.timeouts << '\n';
+        writeHeader(out, "elevator_simulated_seconds", "gauge", "当前模拟时间（模拟秒）");
+        out << "elevator_simulated_seconds " << snapshot.simulatedSeconds << '\n';
+        writeHeader(out, "elevator_sim_speed", "gauge", "每墙钟秒推进的模拟秒数");
+        out << "elevator_sim_speed " << speed << '\n';
+
+        writeHeader(out, "elevator_car_state", "gauge", "电梯当前状态，所处状态为1");
+        for (size_t car = 0; car < snapshot.cars.size(); ++car) {
+            for (ElevatorState state : {ElevatorState::IDLE, ElevatorState::MOVING_UP,
+                                        ElevatorState::MOVING_DOWN, ElevatorState::STOPPED}) {
+                out << "elevator_car_state{car=\"" << car + 1 << "\",state=\"" << stateLabel(state) << "\"} "
+                    << (snapshot.cars[car].state == state ? 1 : 0) << '\n';
+            }
+        }
+        writeHeader(out, "elevator_car_floor", "gauge", "电梯所在楼层");
+        for (size_t car = 0; car < snapshot.cars.size(); ++car) {
+            out << "elevator_car_floor{car=\"" << car + 1 << "\"} " << snapshot.cars[car].floor << '\n';
+        }
+        writeHeader(out, "elevator_car_load", "gauge", "电梯载客人数");
+        for (size_t car = 0; car < snapshot.cars.size(); ++car) {
+            out << "elevator_car_load{car=\"" << car + 1 << "\"} " << snapshot.cars[car].load << '\n';
+        }
+
+        writeHeader(out, "elevator_queue_length", "gauge", "各层各方向候梯人数");
+        for (int floor = 1; floor <= ElevatorConfig::FLOOR_COUNT; ++floor) {
+            out << "elevator_queue_length{floor=\"" << floor << "\",direction=\"up\"} "
+                << snapshot.upQueue[floor - 1] << '\n'
+                << "elevator_queue_length{floor=\"" << floor << "\",direction=\"down\"} "
+                << snapshot.downQueue[floor - 1] << '\n';
+        }
+        out << "# EOF\n";
+        if (!out.good()) return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp, path, error);
+    return !error;
+}
@@ -0,0 +1,76 @@
+#include "MotionModel.h"
+#include "Constants.h"
+#include <cmath>
+
+namespace {
+    // 从静止加速到 speed 所需的时间：加速度能达到上限时为梯形，否则为三角形
+    double rampSeconds(double speed, double acceleration, double jerk) {
+        if (speed * jerk >= acceleration * acceleration) {
+            return speed / acceleration + acceleration / jerk;
+        }
+        return 2.0 * std::sqrt(speed / jerk);
+    }
+}
+
+MotionModel::MotionModel() {
+    rebuild();
+}
+
+double MotionModel::runSeconds(double distance, double speed, double acceleration, double jerk,
+                               double* brakeStart) {
+    if (distance <= 0) {
+        if (brakeStart) *brakeStart = 0;
+        return 0;
+    }
+
+    // 加速段和减速段对称，升到峰值速度 v 再降回 0 共走 v * ramp(v)
+    double ramp = rampSeconds(speed, acceleration, jerk);
+    if (distance >= speed * ramp) {
+        double total = 2.0 * ramp + (distance - speed * ramp) / speed;
+        if (brakeStart) *brakeStart = total - ramp;
+        return total;
+    }
+
+    // 达不到额定速度，按能否达到加速度上限分两种情况解峰值速度
+    double peak;
+    if (distance >= 2.0 * acceleration * acceleration * acceleration / (jerk * jerk)) {
+        double a = acceleration;
+        double k = a / jerk;
+        peak = a / 2.0 * (std::sqrt(k * k + 4.0 * distance / a) - k);
+    } else {
+        peak = std::pow(distance * std::sqrt(jerk) / 2.0, 2.0 / 3.0);
+    }
+    // 加速段在开始收减加速度时就与全力加速的曲线分开，此后不能再改停更远的楼层
+    ramp = rampSeconds(peak, acceleration, jerk);
+    if (brakeStart) {
+        bool reachesAcceleration = peak * jerk >= acceleration * acceleration;
+        *brakeStart = reachesAcceleration ? ramp - acceleration / jerk : ramp / 2.0;
+    }
+    return 2.0 * ramp;
+}
+
+void MotionModel::rebuild() {
+    using namespace ElevatorConfig;
+    kinematic = KINEMATIC_MOTION;
+    runTicks.assign(FLOOR_COUNT, 0);
+    commitTicks.assign(FLOOR_COUNT, 0);
+
+    if (!kinematic) {
+        SimTime floorTicks = SimClock::fromSimSeconds(FLOOR_TIME);
+        doorTicks = SimClock::fromSimSeconds(DOOR_TIME);
+        for (int d = 0; d < FLOOR_COUNT; ++d) {
+            runTicks[d] = d * floorTicks;
+            commitTicks[d] = runTicks[d];
+        }
+        return;
+    }
+
+    // 运动学参数以真实秒计，直接换算为 tick
+    doorTicks = static_cast<SimTime>(std::llround(DOOR_DWELL * SimClock::TICKS_PER_REAL_SECOND));
+    for (int d = 1; d < FLOOR_COUNT; ++d) {
+        double brakeStart = 0;
+        double seconds = runSeconds(d * FLOOR_HEIGHT, RATED_SPEED, ACCELERATION, JERK, &brakeStart);
+        runTicks[d] = static_cast<SimTime>(std::llround(seconds * SimClock::TICKS_PER_REAL_SECOND));
+        commitTicks[d] = static_cast<SimTime>(std::llround(brakeStart * SimClock::TICKS_PER_REAL_SECOND));
+    }
+}
@@ -0,0 +1,53 @@
+#include "PassengerPool.h"
+
+PassengerHandle PassengerPool::allocate(const Passenger& passenger) {
+    PassengerHandle handle;
+    if (!freeList.empty()) {
+        handle = freeList.back();
+        freeList.pop_back();
+    } else {
+        if (usedSlots == slotCapacity()) {
+            slabs.emplace_back(new Passenger[SLAB_SIZE]);
+        }
+        handle = static_cast<PassengerHandle>(usedSlots++);
+    }
+
+    Passenger& slot = (*this)[handle];
+    unsigned serial = slot.serial;
+    slot = passenger;
+    slot.serial = serial;
+    liveRecords++;
+    return handle;
+}
+
+void PassengerPool::release(PassengerHandle handle) {
+    Passenger& slot = (*this)[handle];
+    slot.status = PassengerStatus::FREE;
+    slot.serial++;
+    freeList.push_back(handle);
+    liveRecords--;
+}
+
+PassengerHandle PassengerPool::split(PassengerHandle handle, int count) {
+    // 从一组乘客中分出 count 人成为新记录，原记录保留剩余人数
+    Passenger part = (*this)[handle];
+    part.count = count;
+    (*this)[handle].count -= count;
+    return allocate(part);
+}
+
+void PassengerPool::clear() {
+    // 保留已分配的块，下一次模拟直接复用
+    for (size_t handle = 0; handle < usedSlots; ++handle) {
+        Passenger& slot = (*this)[static_cast<PassengerHandle>(handle)];
+        if (slot.status != PassengerStatus::FREE) {
+            slot.status = PassengerStatus::FREE;
+            slot.serial++;
+        }
+    }
+    freeList.clear();
+    for (size_t handle = usedSlots; handle > 0; --handle) {
+        freeList.push_back(static_cast<PassengerHandle>(handle - 1));
+    }
+    liveRecords = 0;
+}
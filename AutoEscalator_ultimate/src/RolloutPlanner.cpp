@@ -0,0 +1,303 @@
+#include "RolloutPlanner.h"
+#include "BitOps.h"
+#include <algorithm>
+
+namespace {
+    // 电梯各列按电梯数上限预留，只复制在用的前 cars 项
+    void copyState(RolloutPlanner::State& to, const RolloutPlanner::State& from, int cars) {
+        std::copy_n(from.readyAt.begin(), cars, to.readyAt.begin());
+        std::copy_n(from.stops.begin(), cars, to.stops.begin());
+        std::copy_n(from.alight.begin(), cars, to.alight.begin());
+        std::copy_n(from.floor.begin(), cars, to.floor.begin());
+        std::copy_n(from.direction.begin(), cars, to.direction.begin());
+        std::copy_n(from.target.begin(), cars, to.target.begin());
+        std::copy_n(from.load.begin(), cars, to.load.begin());
+        std::copy_n(from.phase.begin(), cars, to.phase.begin());
+        to.head = from.head;
+        to.headTaken = from.headTaken;
+        to.upCalls = from.upCalls;
+        to.downCalls = from.downCalls;
+        to.claimed = from.claimed;
+    }
+}
+
+RolloutPlanner::~RolloutPlanner() {
+    resizePool(0);
+}
+
+void RolloutPlanner::resizePool(int threads) {
+    if (static_cast<int>(workers.size()) == threads) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    stopping = false;
+
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&RolloutPlanner::workerLoop, this);
+    }
+}
+
+void RolloutPlanner::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t seen = jobId;
+    for (;;) {
+        // 只加入仍开放的新任务：醒得太晚、任务已经结束时继续等下一个
+        wake.wait(lock, [&] { return stopping || (jobOpen && jobId != seen); });
+        if (stopping) return;
+        seen = jobId;
+        Job current = job;
+        ++active;
+        lock.unlock();
+
+        drain(current);
+
+        lock.lock();
+        if (--active == 0) {
+            done.notify_all();
+        }
+    }
+}
+
+void RolloutPlanner::drain(const Job& current) {
+    while (!expired.load(std::memory_order_relaxed)) {
+        int i = nextAction.fetch_add(1);
+        if (i >= current.count) break;
+        if (std::chrono::steady_clock::now() > current.deadline) {
+            expired.store(true, std::memory_order_relaxed);
+            break;
+        }
+        current.results[i] = rollout(current, (*current.actions)[i]);
+    }
+}
+
+int RolloutPlanner::choose(const Snapshot& snapshot, const std::vector<Action>& actions, const MotionModel& motion) {
+    int threads = ElevatorConfig::ROLLOUT_THREADS;
+    if (threads < 0) {
+        // 调用线程自己也参与模拟，工作线程数不超过其余候选方案数
+        threads = std::min(static_cast<int>(std::thread::hardware_concurrency()) - 1, snapshot.cars);
+    }
+    resizePool(std::max(threads, 0));
+
+    // 上一次调用已关闭任务并等到所有工作线程退出，此时没有线程在读任务数据
+    Job current;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.assign(actions.size(), SimClock::NEVER);
+        nextAction.store(0);
+        expired.store(false);
+        job.snapshot = &snapshot;
+        job.actions = &actions;
+        job.motion = &motion;
+        job.results = results.data();
+        job.count = static_cast<int>(actions.size());
+        job.deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double, std::micro>(ElevatorConfig::ROLLOUT_BUDGET));
+        jobOpen = true;
+        ++jobId;
+        current = job;
+    }
+    if (actions.size() > 1) {
+        wake.notify_all();
+    }
+    drain(current);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        jobOpen = false;
+        done.wait(lock, [this] { return active == 0; });
+    }
+
+    // 超出预算被放弃的方案代价为 NEVER，不参与比较
+    int best = -1;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i] < SimClock::NEVER && (best < 0 || results[i] < results[best])) {
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+SimTime RolloutPlanner::rollout(const Job& current, const Action& action) {
+    const Snapshot& snapshot = *current.snapshot;
+    const MotionModel& motion = *current.motion;
+    const SimTime door = motion.doorTime();
+    const SimTime horizon = snapshot.horizon;
+    State s;
+    copyState(s, snapshot.start, snapshot.cars);
+    SimTime cost = 0;
+
+    // 超时的乘客按等满时限再加一倍时限计代价
+    auto waitCost = [](const CallGroup& group, SimTime until, int count) {
+        if (group.deadline <= until) return count * 2 * (group.deadline - group.requestTime);
+        return count * (until - group.requestTime);
+    };
+    auto hasCall = [&](int floor, bool up) {
+        return ((up ? s.upCalls : s.downCalls) & BitOps::floorBit(floor)) != 0;
+    };
+    auto advance = [&](int q, int floor, bool up) {
+        s.headTaken[q] = 0;
+        if (++s.head[q] == snapshot.queueLength[q]) {
+            (up ? s.upCalls : s.downCalls) &= ~BitOps::floorBit(floor);
+        }
+    };
+    auto board = [&](int c, int floor, bool up, SimTime t) {
+        int q = queueIndex(floor, up);
+        bool boarded = false;
+        while (s.head[q] < snapshot.queueLength[q] && s.load[c] < ElevatorConfig::MAX_CAPACITY) {
+            const CallGroup& group = snapshot.calls[q][s.head[q]];
+            int left = group.count - s.headTaken[q];
+            if (group.deadline < t) {
+                cost += waitCost(group, t, left);
+                advance(q, floor, up);
+                continue;
+            }
+            int take = std::min(left, ElevatorConfig::MAX_CAPACITY - s.load[c]);
+            cost += take * (t - group.requestTime);
+            s.alight[c][group.targetFloor - 1] += static_cast<uint8_t>(take);
+            s.stops[c] |= BitOps::floorBit(group.targetFloor);
+            s.load[c] += static_cast<uint8_t>(take);
+            boarded = true;
+            if (take == left) {
+                advance(q, floor, up);
+            } else {
+                s.headTaken[q] += static_cast<uint16_t>(take);
+            }
+        }
+        // 满载留下的乘客交给停用的空车
+        if (hasCall(floor, up)) {
+            for (int i = 0; i < snapshot.cars; ++i) {
+                if (s.readyAt[i] == SimClock::NEVER) s.readyAt[i] = t;
+            }
+        }
+        return boarded;
+    };
+    // 沿 dir 方向有任务时返回下一个停靠层：乘客目的层、派梯目标，未满载时还有同向召唤
+    auto nextStop = [&](int c, int dir) {
+        int floor = s.floor[c];
+        uint32_t ahead = dir > 0 ? BitOps::maskAbove(floor) : BitOps::maskBelow(floor);
+        uint32_t work = s.stops[c];
+        if (s.target[c] > 0) work |= BitOps::floorBit(s.target[c]);
+        work &= ahead;
+        if (work == 0) return -1;
+        if (s.load[c] < ElevatorConfig::MAX_CAPACITY) {
+            work |= (dir > 0 ? s.upCalls : s.downCalls) & ahead;
+        }
+        return dir > 0 ? BitOps::lowestFloor(work) : BitOps::highestFloor(work);
+    };
+    auto depart = [&](int c, SimTime t) {
+        int floor = s.floor[c];
+        s.phase[c] = ARRIVE;
+        if (s.direction[c] == 0 && (hasCall(floor, true) || hasCall(floor, false))) {
+            bool up = hasCall(floor, true);
+            if (board(c, floor, up, t)) s.direction[c] = up ? 1 : -1;
+        }
+
+        int dir = s.direction[c];
+        int next = dir != 0 ? nextStop(c, dir) : -1;
+        if (next < 0 && dir != 0) {
+            next = nextStop(c, -dir);
+            dir = -dir;
+        }
+        if (next < 0 && s.load[c] == 0) {
+            // 空车认领最近的一个没有电梯负责的召唤层
+            uint32_t open = (s.upCalls | s.downCalls) & ~s.claimed & ~BitOps::floorBit(floor);
+            for (int i = 0; i < snapshot.cars; ++i) {
+                if (i != c && s.target[i] > 0) open &= ~BitOps::floorBit(s.target[i]);
+            }
+            if (open != 0) {
+                uint32_t above = open & BitOps::maskAbove(floor);
+                uint32_t below = open & BitOps::maskBelow(floor);
+                int up = above != 0 ? BitOps::lowestFloor(above) : -1;
+                int down = below != 0 ? BitOps::highestFloor(below) : -1;
+                next = down < 0 || (up > 0 && up - floor <= floor - down) ? up : down;
+                s.target[c] = static_cast<int8_t>(next);
+                dir = next > floor ? 1 : -1;
+            }
+        }
+        if (next < 0) {
+            s.direction[c] = 0;
+            s.phase[c] = DEPART;
+            s.readyAt[c] = SimClock::NEVER;
+            return;
+        }
+        s.direction[c] = static_cast<int8_t>(dir);
+        s.floor[c] = static_cast<int8_t>(next);
+        s.readyAt[c] = t + motion.travelTime(floor, next);
+    };
+    auto arrive = [&](int c, SimTime t) {
+        int floor = s.floor[c];
+        uint32_t bit = BitOps::floorBit(floor);
+        bool stop = false;
+        if (s.stops[c] & bit) {
+            s.load[c] -= s.alight[c][floor - 1];
+            s.alight[c][floor - 1] = 0;
+            s.stops[c] &= ~bit;
+            stop = true;
+        }
+        if (s.target[c] == floor) s.target[c] = -1;
+
+        // 空车在本层没有同向乘客、前方也没有任务时掉头接反向乘客
+        bool up = s.direction[c] > 0;
+        if (!hasCall(floor, up) && s.load[c] == 0 && nextStop(c, s.direction[c]) < 0 && hasCall(floor, !up)) {
+            up = !up;
+            s.direction[c] = static_cast<int8_t>(-s.direction[c]);
+        }
+        if (hasCall(floor, up) && s.load[c] < ElevatorConfig::MAX_CAPACITY) {
+            stop = board(c, floor, up, t) || stop;
+        }
+        if (stop) {
+            s.phase[c] = DEPART;
+            s.readyAt[c] = t + door;
+        } else {
+            depart(c, t);
+        }
+    };
+
+    if (action.car >= 0) {
+        s.target[action.car] = static_cast<int8_t>(action.floor);
+        s.direction[action.car] = action.floor > s.floor[action.car] ? 1 : -1;
+    } else {
+        s.claimed |= BitOps::floorBit(action.floor);
+    }
+
+    // 每次推进时刻最早的一部电梯，直到所有电梯的下一步都超出模拟时长
+    for (int steps = 1;; ++steps) {
+        if ((steps & 31) == 0 && std::chrono::steady_clock::now() > current.deadline) {
+            expired.store(true, std::memory_order_relaxed);
+            return SimClock::NEVER;
+        }
+
+        int c = -1;
+        SimTime t = horizon;
+        for (int i = 0; i < snapshot.cars; ++i) {
+            if (s.readyAt[i] <= t && (c < 0 || s.readyAt[i] < t)) {
+                c = i;
+                t = s.readyAt[i];
+            }
+        }
+        if (c < 0) break;
+
+        if (s.phase[c] == ARRIVE) {
+            arrive(c, t);
+        } else {
+            depart(c, t);
+        }
+    }
+
+    // 模拟结束时仍在候梯的乘客按等到模拟结束计
+    for (int q = 0; q < QUEUES; ++q) {
+        for (int g = s.head[q]; g < snapshot.queueLength[q]; ++g) {
+            const CallGroup& group = snapshot.calls[q][g];
+            int left = group.count - (g == s.head[q] ? s.headTaken[q] : 0);
+            cost += waitCost(group, horizon, left);
+        }
+    }
+    return cost;
+}
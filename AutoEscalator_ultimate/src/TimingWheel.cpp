@@ -0,0 +1,151 @@
+#include "TimingWheel.h"
+#include "BitOps.h"
+#include <algorithm>
+
+TimingWheel::TimingWheel(size_t timerCount) {
+    reset(timerCount);
+}
+
+void TimingWheel::reset(size_t timerCount, SimTime start) {
+    timers.assign(timerCount, Timer{0, EventType::FLOOR_ARRIVAL, NONE, NONE, NONE});
+    heads.assign(OVERFLOW_SLOT + 1, NONE);
+    tails.assign(OVERFLOW_SLOT + 1, NONE);
+    occupied.assign(LEVELS * WORDS_PER_LEVEL, 0);
+    now = start;
+    armedCount = 0;
+}
+
+void TimingWheel::link(int id) {
+    Timer& timer = timers[id];
+    uint64_t diff = static_cast<uint64_t>(timer.when ^ now);
+    int level = diff == 0 ? 0 : BitOps::highestBit64(diff) / LEVEL_BITS;
+
+    int slot = OVERFLOW_SLOT;
+    if (level < LEVELS) {
+        int index = static_cast<int>((timer.when >> (level * LEVEL_BITS)) & (SLOTS - 1));
+        slot = level * SLOTS + index;
+        occupied[slot / 64] |= uint64_t(1) << (slot % 64);
+    }
+
+    // 追加到链表尾部，同一时刻的计时器按设定顺序到期
+    timer.slot = slot;
+    timer.prev = tails[slot];
+    timer.next = NONE;
+    if (tails[slot] != NONE) {
+        timers[tails[slot]].next = id;
+    } else {
+        heads[slot] = id;
+    }
+    tails[slot] = id;
+}
+
+void TimingWheel::unlink(int id) {
+    Timer& timer = timers[id];
+    int slot = timer.slot;
+    if (timer.prev != NONE) timers[timer.prev].next = timer.next;
+    else heads[slot] = timer.next;
+    if (timer.next != NONE) timers[timer.next].prev = timer.prev;
+    else tails[slot] = timer.prev;
+
+    if (heads[slot] == NONE && slot != OVERFLOW_SLOT) {
+        occupied[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+    }
+    timer.slot = NONE;
+}
+
+void TimingWheel::relinkSlot(int slot) {
+    // 整条链表摘下后按新的当前时刻重新分层
+    int id = heads[slot];
+    heads[slot] = tails[slot] = NONE;
+    if (slot != OVERFLOW_SLOT) {
+        occupied[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+    }
+    while (id != NONE) {
+        int next = timers[id].next;
+        link(id);
+        id = next;
+    }
+}
+
+void TimingWheel::schedule(int id, SimTime when, EventType type) {
+    if (timers[id].slot != NONE) {
+        unlink(id);
+    } else {
+        armedCount++;
+    }
+    timers[id].when = std::max(when, now);
+    timers[id].type = type;
+    link(id);
+}
+
+void TimingWheel::cancel(int id) {
+    if (timers[id].slot == NONE) return;
+    unlink(id);
+    armedCount--;
+}
+
+int TimingWheel::findOccupied(int level, int from) const {
+    for (int index = from; index < SLOTS; index = (index / 64 + 1) * 64) {
+        int slot = level * SLOTS + index;
+        uint64_t word = occupied[slot / 64] & (~uint64_t(0) << (slot % 64));
+        if (word != 0) {
+            return (slot / 64) * 64 + BitOps::lowestBit64(word) - level * SLOTS;
+        }
+    }
+    return NONE;
+}
+
+SimTime TimingWheel::earliestIn(int slot) const {
+    SimTime earliest = SimClock::NEVER;
+    for (int id = heads[slot]; id != NONE; id = timers[id].next) {
+        earliest = std::min(earliest, timers[id].when);
+    }
+    return earliest;
+}
+
+SimTime TimingWheel::nextTime() const {
+    if (armedCount == 0) return SimClock::NEVER;
+
+    // 低层槽位上的计时器总是早于高层，第一层内槽位下标就是到期时刻的最低字节
+    int index = findOccupied(0, static_cast<int>(now & (SLOTS - 1)));
+    if (index != NONE) {
+        return (now & ~static_cast<SimTime>(SLOTS - 1)) | index;
+    }
+    for (int level = 1; level < LEVELS; ++level) {
+        int current = static_cast<int>((now >> (level * LEVEL_BITS)) & (SLOTS - 1));
+        index = current + 1 < SLOTS ? findOccupied(level, current + 1) : NONE;
+        if (index != NONE) {
+            return earliestIn(level * SLOTS + index);
+        }
+    }
+    return earliestIn(OVERFLOW_SLOT);
+}
+
+void TimingWheel::advanceTo(SimTime time) {
+    if (time <= now) return;
+    SimTime previous = now;
+    now = time;
+
+    // 跳过的区间内没有计时器，只需把新时刻所在的高层槽位逐层下放
+    uint64_t changed = static_cast<uint64_t>(previous ^ time);
+    if ((changed >> (LEVELS * LEVEL_BITS)) != 0) {
+        relinkSlot(OVERFLOW_SLOT);
+    }
+    for (int level = LEVELS - 1; level >= 1; --level) {
+        if ((changed >> (level * LEVEL_BITS)) != 0) {
+            int index = static_cast<int>((time >> (level * LEVEL_BITS)) & (SLOTS - 1));
+            relinkSlot(level * SLOTS + index);
+        }
+    }
+}
+
+bool TimingWheel::popDue(int& id, EventType& type) {
+    int slot = static_cast<int>(now & (SLOTS - 1));
+    if (heads[slot] == NONE) return false;
+
+    id = heads[slot];
+    type = timers[id].type;
+    unlink(id);
+    armedCount--;
+    return true;
+}
@@ -0,0 +1,61 @@
+#include "TrafficClassifier.h"
+
+namespace {
+    constexpr int64_t IDLE_PASSENGERS = 6;  // 窗口内少于此人数视为空闲
+    constexpr int64_t PEAK_PERCENT = 60;    // 单一方向首层客流占比达到此值视为高峰
+    constexpr int64_t LUNCH_PERCENT = 25;   // 两个方向首层客流都达到此占比视为午间
+}
+
+void TrafficClassifier::reset(SimTime window) {
+    arrivals.clear();
+    flowCounts.fill(0);
+    windowTicks = window > 0 ? window : 1;
+    current = pending = TrafficMode::IDLE;
+    pendingSince = 0;
+}
+
+TrafficMode TrafficClassifier::record(SimTime time, int sourceFloor, int targetFloor, int count) {
+    Flow flow = sourceFloor == 1 ? FROM_LOBBY : targetFloor == 1 ? TO_LOBBY : INTER;
+    arrivals.push_back(Arrival{time, static_cast<uint32_t>(count), flow});
+    flowCounts[flow] += count;
+    while (arrivals.front().time <= time - windowTicks) {
+        flowCounts[arrivals.front().flow] -= arrivals.front().count;
+        arrivals.pop_front();
+    }
+
+    // 新模式持续四分之一个窗口后才切换
+    TrafficMode candidate = classify();
+    if (candidate == current) {
+        pending = current;
+    } else if (candidate != pending) {
+        pending = candidate;
+        pendingSince = time;
+    } else if (time - pendingSince >= windowTicks / 4) {
+        current = candidate;
+    }
+    return current;
+}
+
+TrafficMode TrafficClassifier::classify() const {
+    int64_t fromLobby = flowCounts[FROM_LOBBY];
+    int64_t toLobby = flowCounts[TO_LOBBY];
+    int64_t total = fromLobby + toLobby + flowCounts[INTER];
+    if (total < IDLE_PASSENGERS) return TrafficMode::IDLE;
+    if (fromLobby * 100 >= total * PEAK_PERCENT) return TrafficMode::UP_PEAK;
+    if (toLobby * 100 >= total * PEAK_PERCENT) return TrafficMode::DOWN_PEAK;
+    if (fromLobby * 100 >= total * LUNCH_PERCENT && toLobby * 100 >= total * LUNCH_PERCENT) {
+        return TrafficMode::LUNCH;
+    }
+    return TrafficMode::INTER_FLOOR;
+}
+
+const char* TrafficClassifier::name(TrafficMode mode) {
+    switch (mode) {
+        case TrafficMode::IDLE: return "空闲";
+        case TrafficMode::UP_PEAK: return "上行高峰";
+        case TrafficMode::DOWN_PEAK: return "下行高峰";
+        case TrafficMode::LUNCH: return "午间双向";
+        case TrafficMode::INTER_FLOOR: return "层间客流";
+    }
+    return "空闲";
+}
@@ -0,0 +1,57 @@
+#include "UtilizationTracker.h"
+#include <algorithm>
+
+SimTime CarUsage::totalTicks() const {
+    SimTime total = 0;
+    for (SimTime value : stateTicks) {
+        total += value;
+    }
+    return total;
+}
+
+void CarUsage::merge(const CarUsage& other) {
+    for (int i = 0; i < STATE_COUNT; ++i) {
+        stateTicks[i] += other.stateTicks[i];
+    }
+    loadTicks += other.loadTicks;
+    floors += other.floors;
+    stops += other.stops;
+    doorCycles += other.doorCycles;
+}
+
+void UtilizationTracker::reset(int cars, SimTime now) {
+    tracks.assign(cars, CarTrack{now, ElevatorState::IDLE, 0});
+    usage.assign(static_cast<size_t>(cars) * HOURS, CarUsage());
+}
+
+void UtilizationTracker::close(const CarTrack& track, SimTime now, CarUsage* hours) {
+    SimTime time = track.since;
+    while (time < now) {
+        SimTime hourEnd = (time / SimClock::TICKS_PER_HOUR + 1) * SimClock::TICKS_PER_HOUR;
+        SimTime segment = std::min(hourEnd, now) - time;
+        CarUsage& slot = hours[hourOf(time)];
+        slot.stateTicks[static_cast<int>(track.state)] += segment;
+        slot.loadTicks += segment * track.load;
+        time += segment;
+    }
+}
+
+void UtilizationTracker::update(int car, SimTime now, ElevatorState state, int load) {
+    CarTrack& track = tracks[car];
+    close(track, now, &usage[static_cast<size_t>(car) * HOURS]);
+    if (state == ElevatorState::STOPPED &&
+        (track.state == ElevatorState::MOVING_UP || track.state == ElevatorState::MOVING_DOWN)) {
+        usage[static_cast<size_t>(car) * HOURS + hourOf(now)].stops++;
+    }
+    track.since = now;
+    track.state = state;
+    track.load = load;
+}
+
+std::vector<CarUsage> UtilizationTracker::report(SimTime now) const {
+    std::vector<CarUsage> result = usage;
+    for (size_t car = 0; car < tracks.size(); ++car) {
+        close(tracks[car], now, &result[car * HOURS]);
+    }
+    return result;
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include <vector>
+#include "SimClock.h"
+
+// 最小代价指派（匈牙利算法），rows 个任务分给 cols 个位置，要求 rows <= cols。
+// 复杂度 O(rows^2 * cols)，工作数组在多次求解之间复用
+class AssignmentSolver {
+private:
+    std::vector<SimTime> rowPotential;
+    std::vector<SimTime> colPotential;
+    std::vector<SimTime> minSlack;
+    std::vector<int> colOwner;
+    std::vector<int> previousCol;
+    std::vector<char> visited;
+    std::vector<int> assignment;
+
+public:
+    // cost 按行存放，返回每行分到的列号
+    const std::vector<int>& solve(const std::vector<SimTime>& cost, int rows, int cols);
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "ElevatorSystem.h"
+
+// 非交互批处理模式：参数来自命令行或配置文件，全速运行一天并输出统计结果
+struct BatchOptions {
+    std::string scenarioFile;
+    bool randomRequests = false;
+    unsigned seed = 0;
+    bool hasSeed = false;
+    int peakRequests = 100;
+    int normalRequests = 50;
+    ElevatorStrategy strategy = ElevatorStrategy::NEAREST_FIRST;
+    std::string jsonOutput;
+    std::string csvOutput;
+    std::string forecastFile;
+    std::string metricsFile;
+    double metricsInterval = 1.0;   // 指标文件的写入间隔（墙钟秒）
+    std::string liveStateName;      // 共享内存状态段的名称
+    std::string liveStateDump;      // 只读取并打印该共享内存状态段
+    int kioskThreads = 0;       // 运行时并发查询乘梯预测的线程数
+    bool quiet = false;
+    bool memoryReport = false;
+    bool selfCheck = false;     // 只运行派梯内核自检
+    bool helpRequested = false;
+};
+
+class BatchRunner {
+private:
+    BatchOptions options;
+    ElevatorSystem system;
+    long long kioskQueries = 0;
+    double kioskQueryMicros = 0.0;  // 每次查询的平均墙钟耗时
+
+    void runKioskQueries(double& wallSeconds);
+    int runSelfCheck() const;
+    int runLiveStateDump() const;
+
+    bool applyOption(const std::string& key, const std::string& value);
+    bool loadConfigFile(const std::string& filename);
+    bool writeJson(const SimulationStats& stats, double wallSeconds) const;
+    bool writeCsv(const SimulationStats& stats, double wallSeconds) const;
+
+public:
+    static void printUsage();
+
+    bool parseArguments(int argc, char* argv[]);
+    int run();
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 楼层位图工具：第 floor 层对应第 (floor - 1) 位
+namespace BitOps {
+    inline uint32_t floorBit(int floor) {
+        return 1u << (floor - 1);
+    }
+
+    // floor 以上（不含）各层的掩码
+    inline uint32_t maskAbove(int floor) {
+        return floor >= 32 ? 0u : ~0u << floor;
+    }
+
+    // floor 以下（不含）各层的掩码
+    inline uint32_t maskBelow(int floor) {
+        return floor <= 1 ? 0u : (~0u >> (33 - floor));
+    }
+
+    // 最低置位对应的楼层，mask 不能为 0
+    inline int lowestFloor(uint32_t mask) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index) + 1;
+#else
+        return __builtin_ctz(mask) + 1;
+#endif
+    }
+
+    // 最高置位对应的楼层，mask 不能为 0
+    inline int highestFloor(uint32_t mask) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse(&index, mask);
+        return static_cast<int>(index) + 1;
+#else
+        return 32 - __builtin_clz(mask);
+#endif
+    }
+
+    // 64 位字中最低置位的下标，word 不能为 0
+    inline int lowestBit64(uint64_t word) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    // 64 位字中最高置位的下标，word 不能为 0
+    inline int highestBit64(uint64_t word) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, word);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(word);
+#endif
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Constants.h"
+#include "BitOps.h"
+
+// 楼层到电梯的索引：按运行类别（空闲、上行、下行、停靠）每层保存一个电梯位集，
+// 并用楼层位图汇总各类别有电梯的楼层。运行中的电梯记在下一次停靠的楼层。
+// 按楼层取电梯、查下一部经过某层的电梯只需几次位运算，位集每 64 部电梯占一个字
+class CarFloorIndex {
+public:
+    enum Category : uint8_t { IDLE, MOVING_UP, MOVING_DOWN, STOPPED, CATEGORY_COUNT };
+
+private:
+    int words = 0;      // 每层位集占用的 64 位字数
+    std::array<std::vector<uint64_t>, CATEGORY_COUNT> carBits;     // [楼层][字]
+    std::array<std::array<uint16_t, ElevatorConfig::FLOOR_COUNT>, CATEGORY_COUNT> counts{};
+    std::array<uint32_t, CATEGORY_COUNT> floorMasks{};
+    std::array<uint16_t, ElevatorConfig::FLOOR_COUNT> targetCounts{};
+    uint32_t targetMask = 0;    // 有电梯以之为派梯目标的楼层
+    std::vector<int8_t> carFloor;
+    std::vector<int8_t> carTarget;
+    std::vector<uint8_t> carCategory;
+
+    void insert(int car, int floor, int category);
+    void erase(int car, int floor, int category);
+
+public:
+    void resize(int cars);
+    // 电梯所在（或下一次停靠）楼层、类别或派梯目标变化时调用，targetFloor 为 -1 表示没有
+    void update(int car, int floor, Category category, int targetFloor);
+
+    uint32_t floors(Category category) const { return floorMasks[category]; }
+    uint32_t targetFloors() const { return targetMask; }
+
+    // 按下标从小到大访问 floor 层某类别的电梯
+    template <typename Visitor>
+    void forEachCar(Category category, int floor, Visitor visit) const;
+    // 沿 up 方向下一部到达 floor 层的运行中电梯（含正停在该层的），没有时返回 -1
+    int nextPassing(int floor, bool up) const;
+};
+
+template <typename Visitor>
+void CarFloorIndex::forEachCar(Category category, int floor, Visitor visit) const {
+    const uint64_t* bits = carBits[category].data() + static_cast<size_t>(floor - 1) * words;
+    for (int w = 0; w < words; ++w) {
+        uint64_t word = bits[w];
+        while (word != 0) {
+            visit(w * 64 + BitOps::lowestBit64(word));
+            word &= word - 1;
+        }
+    }
+}
@@ -1,28 +1,72 @@
-#pragma once
-
-namespace ElevatorConfig {
-    constexpr int FLOOR_COUNT = 14;
-    constexpr int ELEVATOR_COUNT = 4;
-    constexpr int MAX_CAPACITY = 12;
-    
-    extern double FLOOR_TIME;
-    extern double IDLE_MAX_TIME;
-    extern double MAX_WAIT_TIME;
-    extern double DAY_SIMULATION_TIME;
-    
-    constexpr double REAL_SECONDS_PER_SIM_SECOND = 3600.0;
-    constexpr double SIM_SECONDS_PER_DAY = 24.0;
-    
-    void setFloorTime(double time);
-    void setIdleMaxTime(double time);
-    void setMaxWaitTime(double time);
-    void setDaySimulationTime(double time);
-    
-    inline double realTimeToSimTime(double realSeconds) {
-        return realSeconds / REAL_SECONDS_PER_SIM_SECOND;
-    }
-    
-    inline double simTimeToRealTime(double simSeconds) {
-        return simSeconds * REAL_SECONDS_PER_SIM_SECOND;
-    }
+#pragma once
+
+namespace ElevatorConfig {
+    constexpr int FLOOR_COUNT = 14;
+    constexpr int MAX_ELEVATOR_COUNT = 256;    // 电梯数上限，共享内存段和前瞻模拟按此预留空间
+    constexpr int MAX_CAPACITY = 12;
+    
+    extern int ELEVATOR_COUNT;              // 电梯数，下次启动或重置时生效
+
+    extern double FLOOR_TIME;
+    extern double DOOR_TIME;
+    extern double IDLE_MAX_TIME;
+    extern double MAX_WAIT_TIME;
+    extern double DAY_SIMULATION_TIME;
+    extern double DISPATCH_WINDOW;          // 目的层派梯的批处理窗口（模拟秒）
+    constexpr int DISPATCH_BATCH_LIMIT = 32;  // 每批最多分配的乘客组数
+    extern double ROLLOUT_HORIZON;          // 前瞻模拟时长（模拟秒），0 表示取一次往返全程
+    extern double ROLLOUT_BUDGET;           // 每次前瞻派梯的墙钟预算（微秒）
+    extern int ROLLOUT_THREADS;             // 前瞻模拟工作线程数，-1 表示按处理器核数
+    extern bool AUTO_STRATEGY;              // 按识别出的客流模式自动切换策略
+    extern double TRAFFIC_WINDOW;           // 客流模式识别的滑动窗口（模拟秒）
+    extern bool FORECAST_PARKING;           // 空闲电梯按需求预测选择停靠楼层，否则回 1 层
+    extern double FORECAST_DECAY;           // 每天的计数并入历史需求表的权重
+    extern double EMERGENCY_WAIT_TARGET;    // 紧急召唤的候梯时限目标（模拟秒）
+    extern double ACCESSIBILITY_WAIT_TARGET;  // 无障碍召唤的候梯时限目标（模拟秒），普通召唤以 MAX_WAIT_TIME 为准
+    extern double EMERGENCY_SHARE;          // 随机请求中紧急召唤所占比例
+    extern double ACCESSIBILITY_SHARE;      // 随机请求中无障碍召唤所占比例
+    
+    // 运动学模型参数，单位为米和真实秒；未启用时按 FLOOR_TIME、DOOR_TIME 匀速运行
+    extern bool KINEMATIC_MOTION;
+    extern double FLOOR_HEIGHT;
+    extern double RATED_SPEED;
+    extern double ACCELERATION;
+    extern double JERK;
+    extern double DOOR_DWELL;
+    
+    constexpr double REAL_SECONDS_PER_SIM_SECOND = 3600.0;
+    constexpr double SIM_SECONDS_PER_DAY = 24.0;
+    
+    void setElevatorCount(int count);
+    void setFloorTime(double time);
+    void setDoorTime(double time);
+    void setIdleMaxTime(double time);
+    void setMaxWaitTime(double time);
+    void setDaySimulationTime(double time);
+    void setDispatchWindow(double time);
+    void setRolloutHorizon(double time);
+    void setRolloutBudget(double microseconds);
+    void setRolloutThreads(int threads);
+    void setAutoStrategy(bool enabled);
+    void setTrafficWindow(double time);
+    void setForecastParking(bool enabled);
+    void setForecastDecay(double weight);
+    void setEmergencyWaitTarget(double time);
+    void setAccessibilityWaitTarget(double time);
+    void setPriorityShares(double emergency, double accessibility);
+    void setKinematicMotion(bool enabled);
+    void setFloorHeight(double meters);
+    void setRatedSpeed(double speed);
+    void setAcceleration(double acceleration);
+    void setJerk(double jerk);
+    void setDoorDwell(double seconds);
+    
+    inline double realTimeToSimTime(double realSeconds) {
+        return realSeconds / REAL_SECONDS_PER_SIM_SECOND;
+    }
+    
+    inline double simTimeToRealTime(double simSeconds) {
+        return simSeconds * REAL_SECONDS_PER_SIM_SECOND;
+    }
+
 } 
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <queue>
+#include <vector>
+#include "PassengerPool.h"
+
+// 按请求时刻加最长等待时间排序的超时索引。已上车或已回收的记录不从堆中删除，
+// 其条目在到达堆顶时按池中的状态和序号判定失效并丢弃，因此每次超时处理为均摊 O(log n)
+class DeadlineIndex {
+public:
+    struct Entry {
+        SimTime deadline;
+        PassengerHandle handle;
+        unsigned serial;
+        int floor;
+        bool up;
+    };
+
+private:
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.deadline > b.deadline;
+        }
+    };
+
+    const PassengerPool& pool;
+    std::priority_queue<Entry, std::vector<Entry>, Later> heap;
+
+    void discardStale();
+
+public:
+    explicit DeadlineIndex(const PassengerPool& passengerPool) : pool(passengerPool) {}
+
+    void add(PassengerHandle handle);
+    bool empty();
+    SimTime nextDeadline();
+    Entry pop();
+    void clear();
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include "Constants.h"
+#include "SimClock.h"
+
+// 分楼层、分时段的召唤需求预测，供空闲电梯选择停靠楼层。
+// 历史表按一天 96 个时段（每段 15 分钟）记录各层平均召唤人数，每跑完一天
+// 按指数衰减并入当天的计数，可存盘供下次运行使用；运行中另记一份随时间指数
+// 衰减的近期召唤人数，没有历史数据时只用近期数据
+class DemandForecast {
+public:
+    static constexpr int SLOTS_PER_DAY = 96;
+    static constexpr SimTime SLOT_TICKS = 15 * 60 * SimClock::TICKS_PER_REAL_SECOND;
+
+    using FloorDemand = std::array<double, ElevatorConfig::FLOOR_COUNT>;
+
+private:
+    std::vector<FloorDemand> history;   // [时段][楼层]
+    std::vector<FloorDemand> today;
+    bool hasHistory = false;
+    FloorDemand recent{};               // 时间常数为一个时段的衰减计数
+    SimTime recentTime = 0;
+
+    static int slotOf(SimTime time);
+
+public:
+    DemandForecast();
+    // 开始新的一天，保留历史表
+    void reset();
+    void record(SimTime time, int floor, int count);
+    // time 起一个时段内各层的预计召唤人数
+    FloorDemand demand(SimTime time) const;
+    // 把 [0, endTime) 内各时段的计数按权重 weight 并入历史表
+    void finishDay(SimTime endTime, double weight);
+
+    bool load(const std::string& filename);
+    bool save(const std::string& filename) const;
+};
@@ -1,32 +1,58 @@
-#pragma once
-#include <vector>
-#include "Passenger.h"
-
-enum class ElevatorState {
-    IDLE,
-    MOVING_UP,
-    MOVING_DOWN,
-    STOPPED
-};
-
-class Elevator {
-private:
-    int currentFloor;
-    int capacity;
-    std::vector<Passenger> passengers;
-    ElevatorState state;
-    double idleTimer;
-
-public:
-    Elevator();
-    void move();
-    bool addPassenger(const Passenger& passenger);
-    void removePassenger(int floor);
-    void update(double deltaTime);
-    int getCurrentFloor() const;
-    int getCurrentLoad() const;
-    ElevatorState getState() const;
-    void setState(ElevatorState newState);
-    bool hasStopRequest(int floor) const;
-    void updateMovement(double deltaTime);
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include "Passenger.h"
+#include "FixedVector.h"
+
+static_assert(ElevatorConfig::FLOOR_COUNT <= 127, "电梯楼层用 int8_t 保存");
+
+enum class ElevatorState : uint8_t {
+    IDLE,
+    MOVING_UP,
+    MOVING_DOWN,
+    STOPPED
+};
+
+class Elevator {
+public:
+    // 车厢内只保存乘客记录的句柄，并缓存停靠判断所需的目标楼层和人数
+    struct Rider {
+        PassengerHandle handle;
+        uint8_t targetFloor;
+        uint8_t count;
+    };
+
+    using RiderList = FixedVector<Rider, ElevatorConfig::MAX_CAPACITY>;
+
+private:
+    // 乘客直接内联存放在电梯对象中，整个电梯组的状态是一段连续内存
+    RiderList passengers;
+    std::array<uint8_t, ElevatorConfig::FLOOR_COUNT> alightCount;  // 各层下车人数
+    uint32_t stopMask;      // 有乘客要下车的楼层位图
+    int8_t currentFloor;
+    int8_t direction;       // 1 上行，-1 下行，0 无方向；停靠开门时保留原方向
+    int8_t dispatchFloor;   // 空车前往的目标楼层（返回基站或响应召唤），-1 表示没有
+    uint8_t capacity;
+    uint8_t load;
+    ElevatorState state;
+
+public:
+    Elevator();
+    void move();
+    void moveTo(int floor);
+    bool addPassenger(PassengerHandle handle, const Passenger& passenger);
+    void removePassenger(int floor, std::vector<PassengerHandle>& alighted);
+    const RiderList& getPassengers() const;
+    int getCurrentFloor() const;
+    int getCurrentLoad() const;
+    ElevatorState getState() const;
+    void setState(ElevatorState newState);
+    bool hasStopRequest(int floor) const;
+    bool hasRequestAbove() const;
+    bool hasRequestBelow() const;
+    uint32_t getStopMask() const;
+    int getDirection() const;
+    int getDispatchFloor() const;
+    void setDispatchFloor(int floor);
 }; 
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Constants.h"
+#include "SimClock.h"
+#include "MotionModel.h"
+#include "EtaProfile.h"
+#include "Passenger.h"
+#include "CarFloorIndex.h"
+
+// 派梯查询用的电梯组状态，按列连续存放：楼层、运行状态、载客数、锚点时刻，
+// 以及按（楼层，方向）转置存放的预计到达偏移。每列长度补齐到 4 的倍数，
+// 一次召唤对所有电梯的代价由 AVX2 内核一次算出，不支持 AVX2 时走标量版本；
+// 电梯很多时改用楼层索引由近及远搜索，预计到达时间的下界超过已找到的最优值即停止。
+// 电梯状态变化后由 ElevatorSystem 调用 update 同步对应的一列
+class ElevatorFleet {
+public:
+    // 运行状态编码，与车厢运行方向一致便于向量比较
+    static constexpr int64_t MOVING_DOWN = -1;
+    static constexpr int64_t IDLE = 0;
+    static constexpr int64_t MOVING_UP = 1;
+    static constexpr int64_t STOPPED = 2;
+    static constexpr int LANES = 4;
+    static constexpr int FLOOR_SEARCH_MIN_CARS = 128;   // 多于此数的电梯组按楼层索引搜索
+
+    enum class Filter {
+        AVAILABLE,              // 空闲，或运行方向朝向乘客目的层
+        MOVING_TOWARD_TARGET,   // 运行方向朝向乘客目的层
+        MOVING_TOWARD_SOURCE    // 同上，且还没有驶过乘客所在楼层
+    };
+
+    // 计算一部电梯的预计到达时间所需的状态
+    struct CarStatus {
+        int floor;
+        int64_t motion;
+        int load;
+        SimTime anchorTime;     // 下一次停在某层的时刻，空闲电梯为 0（按当前时刻计）
+        int anchorFloor;
+        int dispatchFloor;
+        int direction;
+        uint32_t stops;
+        bool stopsAtAnchor;
+    };
+
+    // 选梯内核；AUTO 按电梯数和处理器支持自动选择
+    enum class Kernel { AUTO, SCALAR, AVX2, FLOOR_SEARCH };
+
+private:
+    int cars = 0;
+    int stride = 0;
+    std::vector<int64_t> floors;
+    std::vector<int64_t> motions;
+    std::vector<int64_t> loads;
+    std::vector<int64_t> anchors;
+    std::vector<int64_t> offsets;   // [楼层方向][电梯]
+    std::vector<EtaProfile> profiles;
+    CarFloorIndex floorIndex;
+
+    static int queueIndex(int floor, bool up) { return (floor - 1) * 2 + (up ? 0 : 1); }
+    int bestCarWith(Kernel kernel, const Passenger& passenger, Filter filter, SimTime now,
+                    const MotionModel& motion) const;
+
+public:
+    void resize(int carCount);
+    void update(int car, const CarStatus& status, const MotionModel& motion);
+    void invalidateProfiles();
+
+    int size() const { return cars; }
+    const CarFloorIndex& index() const { return floorIndex; }
+    SimTime eta(int car, int floor, bool up, SimTime now) const {
+        SimTime start = anchors[car] > now ? anchors[car] : now;
+        return start - now + offsets[static_cast<size_t>(queueIndex(floor, up)) * stride + car];
+    }
+
+    // 电梯已登记的停靠层（不含锚点楼层）
+    uint32_t stops(int car) const { return profiles[car].stops(); }
+
+    // 满足 filter 的电梯中，能装下整组乘客的优先，再比较预计到达时间；没有时返回 -1
+    int bestCar(const Passenger& passenger, Filter filter, SimTime now, const MotionModel& motion) const {
+        return bestCarWith(Kernel::AUTO, passenger, filter, now, motion);
+    }
+    static bool hasAvx2();
+
+    // 自检：随机生成 1..maxCars 部电梯的电梯组和召唤，比较各内核与标量版本选出的电梯，
+    // 返回不一致的次数。处理器不支持 AVX2 时只比较楼层索引搜索
+    static long long selfCheck(int maxCars, int rounds, unsigned seed);
+};
@@ -1,66 +1,252 @@
-#pragma once
-#include <vector>
-#include <queue>
-#include <random>
-#include "Elevator.h"
-
-enum class InputMode {
-    RANDOM,
-    FILE,
-    MANUAL
-};
-
-enum class ElevatorStrategy {
-    NEAREST_FIRST,
-    SCAN,
-    LOOK
-};
-
-class ElevatorSystem {
-private:
-    std::vector<Elevator> elevators;
-    std::queue<Passenger> waitingPassengers;
-    double currentTime;
-    std::vector<int> floorRequests;
-    std::vector<int> hourlyRequests;
-    int totalRequests = 0;
-    int timeoutRequests = 0;
-    double totalWaitTime = 0.0;
-
-    struct RequestConfig {
-        int peakTimeRequests = 100;
-        int normalTimeRequests = 50;
-    } requestConfig;
-
-    ElevatorStrategy currentStrategy = ElevatorStrategy::NEAREST_FIRST;
-
-    void processWaitingPassengers();
-    void generatePeakTimeRequests(double startHour, double endHour, bool isUpPeak, std::mt19937& gen);
-    void generateNormalTimeRequests(std::mt19937& gen);
-    void updateStatistics();
-    void assignElevator(const Passenger& passenger);
-    bool isElevatorAvailable(const Elevator& elevator, const Passenger& passenger) const;
-    int findBestElevator(const Passenger& passenger) const;
-    int findNearestElevator(const Passenger& passenger) const;
-    int findScanElevator(const Passenger& passenger) const;
-    int findLookElevator(const Passenger& passenger) const;
-
-public:
-    ElevatorSystem();
-    void start();
-    void reset();
-    void update(double deltaTime);
-    void loadRandomRequests();
-    void loadFileRequests(const std::string& filename);
-    void addManualRequest(int from, int to, int count, double time);
-    void printStatistics() const;
-    void printCurrentStatus() const;
-    void setElevatorSpeed(double speed);
-    void setMaxWaitTime(double time);
-    void setMaxIdleTime(double time);
-    void setRequestCounts(int peakCount, int normalCount);
-    int getPeakRequestCount() const { return requestConfig.peakTimeRequests; }
-    int getNormalRequestCount() const { return requestConfig.normalTimeRequests; }
-    void setStrategy(ElevatorStrategy strategy);
-    ElevatorStrategy getStrategy() const { return currentStrategy; }
+#pragma once
+#include <vector>
+#include <array>
+#include <queue>
+#include <random>
+#include "Elevator.h"
+#include "EventQueue.h"
+#include "TimingWheel.h"
+#include "MotionModel.h"
+#include "ElevatorFleet.h"
+#include "AssignmentSolver.h"
+#include "RolloutPlanner.h"
+#include "TrafficClassifier.h"
+#include "DemandForecast.h"
+#include "JourneyPredictor.h"
+#include "UtilizationTracker.h"
+#include "MetricsExporter.h"
+#include "LiveStateSegment.h"
+#include <memory>
+#include <utility>
+#include "PassengerPool.h"
+#include "HallCallQueues.h"
+#include "DeadlineIndex.h"
+#include "SimulationStats.h"
+
+enum class InputMode {
+    RANDOM,
+    FILE,
+    MANUAL
+};
+
+enum class ElevatorStrategy {
+    NEAREST_FIRST,
+    SCAN,
+    LOOK,
+    DESTINATION_DISPATCH,
+    ROLLOUT
+};
+
+class ElevatorSystem {
+private:
+    std::vector<Elevator> elevators;
+    struct PendingArrival {
+        SimTime requestTime;
+        PassengerHandle handle;
+        uint32_t sequence;      // 加入顺序，同一时刻的请求按它先来先到
+    };
+
+    struct LaterRequest {
+        bool operator()(const PendingArrival& a, const PendingArrival& b) const {
+            if (a.requestTime != b.requestTime) return a.requestTime > b.requestTime;
+            return a.sequence > b.sequence;
+        }
+    };
+
+    PassengerPool passengerPool;
+    // 尚未到达请求时间的乘客按 requestTime 排成小顶堆，到时间才进入等待队列
+    std::priority_queue<PendingArrival, std::vector<PendingArrival>, LaterRequest> pendingArrivals;
+    uint32_t arrivalSequence = 0;
+    HallCallQueues hallCalls{passengerPool};
+    DeadlineIndex deadlines{passengerPool};
+    std::vector<PassengerHandle> alightedScratch;
+    std::vector<int> boardingCars;
+    EventQueue events;          // 乘客到达事件
+    TimingWheel carTimers;      // 每部电梯一个计时器：到站、关门、空闲返回
+    MotionModel motion;
+
+    // 运动学模型下电梯一次出发直接运行到目标层，运行途中楼层不变
+    struct CarRun {
+        SimTime departure = 0;
+        int8_t fromFloor = 1;
+        int8_t targetFloor = 1;
+    };
+    std::vector<CarRun> runs;
+    // 派梯查询用的按列存放的电梯组状态；电梯状态变化时只做标记，查询前再同步
+    mutable ElevatorFleet fleet;
+    mutable std::vector<uint8_t> fleetDirty;
+    mutable bool fleetStale = true;
+    // 乘梯预测快照：开启后，电梯组状态变化时在一个时刻的事件处理完后重新发布
+    JourneyPredictor journeys;
+    bool journeysEnabled = false;
+    bool journeysStale = true;
+    std::shared_ptr<const MotionModel> journeyMotion;   // 运行时间表变化前各快照共用
+    // 指标文件导出：开启后按墙钟间隔采样，由导出器的线程写文件
+    std::unique_ptr<MetricsExporter> metrics;
+    // 共享内存状态段：开启后每处理完一个时刻的事件就发布一次
+    LiveStateSegment liveSegment;
+    LiveStateData liveState{};
+
+    // 目的层派梯：新到达的乘客先积累一个批处理窗口，再按（出发层，目的层）分组整批指派
+    struct UnassignedCall {
+        PassengerHandle handle;
+        uint32_t serial;
+    };
+
+    struct CallGroup {
+        int sourceFloor;
+        int targetFloor;
+        int count;
+        size_t firstCall;   // 在 batchCalls 中的起始位置
+        size_t callCount;
+    };
+
+    // 每部电梯已分配、尚未上车的乘客，按出发层和方向计人数，并记录他们的目的层
+    struct PickupCalls {
+        std::array<uint16_t, ElevatorConfig::FLOOR_COUNT> up{};
+        std::array<uint16_t, ElevatorConfig::FLOOR_COUNT> down{};
+        std::array<uint16_t, ElevatorConfig::FLOOR_COUNT> targets{};
+        uint32_t upMask = 0;
+        uint32_t downMask = 0;
+        uint32_t targetMask = 0;
+        int total = 0;
+    };
+
+    // 尚在候梯的紧急、无障碍召唤，car 为改派去接它的电梯，没有时为 -1
+    struct PriorityCall {
+        PassengerHandle handle;
+        uint32_t serial;
+        int car;
+    };
+
+    std::vector<UnassignedCall> unassignedCalls;
+    std::vector<PassengerHandle> batchCalls;
+    std::vector<CallGroup> callGroups;
+    std::vector<SimTime> assignmentCost;
+    std::vector<PickupCalls> pickups;
+    AssignmentSolver assignmentSolver;
+    bool batchScheduled = false;
+
+    // 前瞻模拟派梯的快照和候选方案，选梯函数每次调用时复用
+    mutable RolloutPlanner rolloutPlanner;
+    mutable RolloutPlanner::Snapshot rolloutSnapshot;
+    mutable std::vector<RolloutPlanner::Action> rolloutActions;
+    SimTime currentTime;    // 整数 tick，避免长时间运行后浮点累加误差
+    std::vector<int> floorRequests;
+    std::vector<int> hourlyRequests;
+    int totalRequests = 0;
+    int timeoutRequests = 0;
+    double totalWaitTime = 0.0;
+    TrafficClassifier traffic;
+    int strategySwitches = 0;
+    DemandForecast forecast;
+    std::vector<PriorityCall> priorityCalls;
+    std::array<LatencyHistogram, PRIORITY_CLASS_COUNT> classWaits;
+    std::array<int, PRIORITY_CLASS_COUNT> classWithinTarget{};
+    std::array<int, PRIORITY_CLASS_COUNT> classTimeouts{};
+    JourneyLatency journeyLatency;
+    UtilizationTracker utilization;
+    std::mt19937 priorityGen;   // 随机请求的召唤类别单独取数，不影响请求本身的随机序列
+
+    struct RequestConfig {
+        int peakTimeRequests = 100;
+        int normalTimeRequests = 50;
+    } requestConfig;
+
+    ElevatorStrategy currentStrategy = ElevatorStrategy::NEAREST_FIRST;
+
+    void processWaitingPassengers();
+    void releaseArrivals();
+    void expireOverdue();
+    SimTime nextWakeupTime();
+    void advanceTo(SimTime endTime);
+    void addRequestAt(int from, int to, int count, SimTime time,
+                      PriorityClass priority = PriorityClass::NORMAL);
+    PriorityClass randomPriority();
+    void enqueueCall(PassengerHandle handle);
+    void recordBoarding(Passenger& passenger);
+    void dispatchPriorityCalls();
+    SimTime directArrival(int elevatorIndex, int floor) const;
+    bool isPriorityResponder(int elevatorIndex) const;
+    void dispatchIdleElevators();
+    int boardPassengers(Elevator& elevator, int floor, bool up);
+    int boardAssigned(int elevatorIndex, int floor, bool up);
+    uint32_t pickupMask(int elevatorIndex, bool up) const;
+    void scheduleDispatchBatch();
+    void assignDestinationBatch();
+    void addPickup(int elevatorIndex, const Passenger& passenger);
+    void removePickup(int elevatorIndex, const Passenger& passenger);
+    void dispatchAssignedElevators();
+    void resetAssignments();
+    void applyTrafficMode(TrafficMode mode);
+    static ElevatorStrategy strategyFor(TrafficMode mode);
+    void clearPassengers();
+    void generatePeakTimeRequests(double startHour, double endHour, bool isUpPeak, std::mt19937& gen);
+    void generateNormalTimeRequests(std::mt19937& gen);
+    void handleCarEvent(int elevatorIndex, EventType type);
+    int chooseParkingFloor(int elevatorIndex) const;
+    void changeState(int elevatorIndex, ElevatorState newState);
+    void startRun(int elevatorIndex);
+    int planRunTarget(int elevatorIndex) const;
+    void retargetRuns();
+    void rebuildMotion();
+    void markFleetDirty(int elevatorIndex);
+    void markFleetDirty();
+    void refreshFleet() const;
+    void publishJourneys();
+    void captureMetrics();      // 只填写导出器的快照
+    void publishMetrics();
+    void publishLiveState();
+    SimTime estimateArrival(int elevatorIndex, const Passenger& passenger) const;
+    int findBestElevator(const Passenger& passenger) const;
+    int findNearestElevator(const Passenger& passenger) const;
+    int findScanElevator(const Passenger& passenger) const;
+    int findLookElevator(const Passenger& passenger) const;
+    int findRolloutElevator(const Passenger& passenger) const;
+    void captureRolloutSnapshot() const;
+
+public:
+    ElevatorSystem();
+    void start();
+    void reset();
+    void update(double deltaTime);
+    void runUntil(double endTime);
+    double getCurrentTime() const { return SimClock::toSimSeconds(currentTime); }
+    SimTime getCurrentTick() const { return currentTime; }
+    void loadRandomRequests();
+    void loadRandomRequests(unsigned seed);
+    bool loadFileRequests(const std::string& filename);
+    bool loadForecast(const std::string& filename) { return forecast.load(filename); }
+    // 把本次运行的召唤计数并入历史需求表后存盘
+    bool saveForecast(const std::string& filename);
+    void addManualRequest(int from, int to, int count, double time,
+                          PriorityClass priority = PriorityClass::NORMAL);
+    // 不改动仿真状态的乘梯预测：按当前策略会派哪部电梯、候梯和乘梯各需多久。
+    // 可在仿真运行时从多个线程并发调用，time 为模拟秒，早于最近一次发布的状态时按其时刻计
+    JourneyPrediction predict(int from, int to, double time) const;
+    // 开启后才发布预测快照，关闭时 predict 返回最后一次发布的结果
+    void enableJourneyPrediction(bool enabled);
+    // 每隔 intervalSeconds 墙钟秒把计数、电梯状态和各层候梯人数写成 OpenMetrics 文本文件
+    void enableMetricsExport(const std::string& filename, double intervalSeconds);
+    // 写出最后一次指标并停止导出，返回导出期间的写入是否都成功
+    bool disableMetricsExport();
+    // 把电梯状态、楼层、载客人数和各层候梯人数发布到 POSIX 共享内存段 name，
+    // 外部监控程序用 LiveStateSegment::attach 映射后读取；平台不支持或创建失败时返回 false
+    bool enableLiveState(const std::string& name);
+    void disableLiveState() { liveSegment.close(); }
+    static SimTime waitTarget(PriorityClass priority);
+    static const char* priorityName(PriorityClass priority);
+    void printStatistics() const;
+    SimulationStats getStatistics() const;
+    void printCurrentStatus() const;
+    void printMemoryFootprint() const;
+    void setElevatorSpeed(double speed);
+    void setMaxWaitTime(double time);
+    void setMaxIdleTime(double time);
+    void setRequestCounts(int peakCount, int normalCount);
+    int getPeakRequestCount() const { return requestConfig.peakTimeRequests; }
+    int getNormalRequestCount() const { return requestConfig.normalTimeRequests; }
+    void setStrategy(ElevatorStrategy strategy);
+    ElevatorStrategy getStrategy() const { return currentStrategy; }
+    TrafficMode getTrafficMode() const { return traffic.mode(); }
 }; 
\ No newline at end of file
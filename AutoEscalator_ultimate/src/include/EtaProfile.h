@@ -0,0 +1,30 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Constants.h"
+#include "SimClock.h"
+#include "MotionModel.h"
+
+// 单部电梯到达各层各方向召唤的预计时间，按集选控制的运行路线估算：
+// 先沿当前方向服务完已登记的停靠层，到最远停靠层掉头，途中每个停靠层加一次开关门时间。
+// 时间相对“锚点”（电梯下一次停在某层的时刻）保存，只在锚点楼层、方向或停靠层集合变化时重算
+class EtaProfile {
+private:
+    std::array<SimTime, ElevatorConfig::FLOOR_COUNT> upOffsets{};
+    std::array<SimTime, ElevatorConfig::FLOOR_COUNT> downOffsets{};
+    uint32_t stopMask = 0;
+    int anchorFloor = -1;
+    int direction = 0;
+    bool anchorStop = false;
+
+    void rebuild(const MotionModel& motion);
+
+public:
+    // 状态与上次相同时直接返回 false，否则重算并返回 true
+    bool update(int floor, int dir, uint32_t stops, bool stopsAtAnchor, const MotionModel& motion);
+    SimTime offset(int floor, bool up) const {
+        return up ? upOffsets[floor - 1] : downOffsets[floor - 1];
+    }
+    uint32_t stops() const { return stopMask; }
+    void invalidate() { anchorFloor = -1; }
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <queue>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "SimClock.h"
+
+enum class EventType {
+    PASSENGER_ARRIVAL,
+    DISPATCH_BATCH,
+    FLOOR_ARRIVAL,
+    DOOR_CLOSE,
+    IDLE_TIMEOUT
+};
+
+struct SimEvent {
+    SimTime time;
+    EventType type;
+    uint64_t sequence;      // 同一时刻的事件按加入顺序处理
+};
+
+class EventQueue {
+private:
+    struct Later {
+        bool operator()(const SimEvent& a, const SimEvent& b) const {
+            if (a.time != b.time) return a.time > b.time;
+            return a.sequence > b.sequence;
+        }
+    };
+
+    std::priority_queue<SimEvent, std::vector<SimEvent>, Later> events;
+    uint64_t nextSequence = 0;
+
+public:
+    void schedule(SimTime time, EventType type);
+    SimEvent pop();
+    bool empty() const { return events.empty(); }
+    SimTime nextTime() const { return events.top().time; }
+    size_t size() const { return events.size(); }
+    void clear();
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// 容量在编译期确定的内联顺序容器，元素直接存放在对象内部，不做堆分配
+template <typename T, size_t N>
+class FixedVector {
+    static_assert(N <= 255, "FixedVector 的元素个数用 uint8_t 记录");
+
+private:
+    std::array<T, N> items{};
+    uint8_t count = 0;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    bool push_back(const T& value) {
+        if (count == N) return false;
+        items[count++] = value;
+        return true;
+    }
+
+    iterator erase(iterator first, iterator last) {
+        iterator out = first;
+        for (iterator it = last; it != end(); ++it) {
+            *out++ = *it;
+        }
+        count = static_cast<uint8_t>(out - begin());
+        return first;
+    }
+
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    static constexpr size_t capacity() { return N; }
+
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+
+    iterator begin() { return items.data(); }
+    iterator end() { return items.data() + count; }
+    const_iterator begin() const { return items.data(); }
+    const_iterator end() const { return items.data() + count; }
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "PassengerPool.h"
+#include "Constants.h"
+#include "BitOps.h"
+
+static_assert(ElevatorConfig::FLOOR_COUNT <= 32, "楼层位图使用 32 位整数");
+
+// 每层楼分上行、下行两条候梯队列，并用位图汇总有召唤的楼层。
+// 队列是按句柄下标存放前后链接的双向链表，每个句柄记着自己所在的队列，
+// 超时乘客不论排在第几位都能 O(1) 摘除。每条队列另记候梯人数，增删时按池中记录的人数增减
+class HallCallQueues {
+public:
+    static constexpr PassengerHandle NONE = UINT32_MAX;
+
+private:
+    static constexpr int QUEUE_COUNT = ElevatorConfig::FLOOR_COUNT * 2;
+
+    struct Link {
+        PassengerHandle prev = NONE;
+        PassengerHandle next = NONE;
+        int16_t queue = -1;     // 所在队列，不在任何队列中为 -1
+    };
+
+    struct Queue {
+        PassengerHandle head = NONE;
+        PassengerHandle tail = NONE;
+        uint32_t people = 0;
+    };
+
+    const PassengerPool& pool;
+    std::array<Queue, QUEUE_COUNT> queues;
+    std::vector<Link> links;
+    uint32_t upCalls = 0;
+    uint32_t downCalls = 0;
+    size_t waitingCount = 0;
+
+    static int queueIndex(int floor, bool up) { return (floor - 1) * 2 + (up ? 0 : 1); }
+    void link(PassengerHandle handle, int floor, bool up, PassengerHandle before);
+    void unlink(PassengerHandle handle, int floor, bool up);
+
+public:
+    explicit HallCallQueues(const PassengerPool& passengers) : pool(passengers) {}
+
+    // 按排队顺序遍历一条队列，遍历期间不能增删该队列的乘客
+    class Iterator {
+    private:
+        const Link* links;
+        PassengerHandle handle;
+
+    public:
+        Iterator(const Link* linkArray, PassengerHandle current) : links(linkArray), handle(current) {}
+        PassengerHandle operator*() const { return handle; }
+        Iterator& operator++() {
+            handle = links[handle].next;
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const { return handle != other.handle; }
+    };
+
+    class Range {
+    private:
+        const Link* links;
+        PassengerHandle head;
+
+    public:
+        Range(const Link* linkArray, PassengerHandle first) : links(linkArray), head(first) {}
+        Iterator begin() const { return Iterator(links, head); }
+        Iterator end() const { return Iterator(links, NONE); }
+    };
+
+    void push(PassengerHandle handle, int floor, bool up) { link(handle, floor, up, NONE); }
+    // 插到 before 之前，before 为 NONE 时排到队尾；用于优先召唤插队
+    void insertBefore(PassengerHandle handle, int floor, bool up, PassengerHandle before) {
+        link(handle, floor, up, before);
+    }
+    PassengerHandle front(int floor, bool up) const { return queues[queueIndex(floor, up)].head; }
+    void pop(int floor, bool up) { unlink(front(floor, up), floor, up); }
+    // 乘客不在这条队列中时返回 false
+    bool remove(int floor, bool up, PassengerHandle handle);
+    // 队列中的一组乘客拆出 people 人上车、其余继续候梯时调用
+    void split(int floor, bool up, int people) { queues[queueIndex(floor, up)].people -= people; }
+    Range queue(int floor, bool up) const { return Range(links.data(), front(floor, up)); }
+    // 一次遍历删除队列中满足条件的乘客，保持其余乘客的先后顺序
+    template <typename Predicate>
+    size_t removeIf(int floor, bool up, Predicate predicate);
+    void clear();
+
+    bool empty() const { return waitingCount == 0; }
+    size_t size() const { return waitingCount; }
+    uint32_t waitingPeople(int floor, bool up) const { return queues[queueIndex(floor, up)].people; }
+
+    uint32_t upCallMask() const { return upCalls; }
+    uint32_t downCallMask() const { return downCalls; }
+    uint32_t callMask() const { return upCalls | downCalls; }
+    bool hasCall(int floor, bool up) const;
+};
+
+template <typename Predicate>
+size_t HallCallQueues::removeIf(int floor, bool up, Predicate predicate) {
+    size_t removed = 0;
+    PassengerHandle handle = front(floor, up);
+    while (handle != NONE) {
+        PassengerHandle next = links[handle].next;
+        if (predicate(handle)) {
+            unlink(handle, floor, up);
+            ++removed;
+        }
+        handle = next;
+    }
+    return removed;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <vector>
+#include "Constants.h"
+#include "SimClock.h"
+#include "Passenger.h"
+#include "LatencyHistogram.h"
+
+// 每组乘客的候梯、乘梯和全程时间，分别按全部、出发楼层和方向、请求时段记入直方图。
+// 候梯时间在上车时记录，乘梯和全程时间在下车时记录，均按组内人数计数；
+// 直方图存放在堆上，同样配置下的两份统计可以逐个直方图合并
+class JourneyLatency {
+public:
+    enum Metric { WAIT, RIDE, JOURNEY, METRIC_COUNT };
+    static constexpr int HOURS = 24;
+
+private:
+    static constexpr int FLOOR_SLOTS = ElevatorConfig::FLOOR_COUNT * 2;
+    static constexpr int SLOTS = 1 + FLOOR_SLOTS + HOURS;    // 全部、各层各方向、各时段
+    std::vector<LatencyHistogram> histograms;                // [指标][分组]
+
+    LatencyHistogram& at(Metric metric, int slot) {
+        return histograms[static_cast<size_t>(metric) * SLOTS + slot];
+    }
+    const LatencyHistogram& at(Metric metric, int slot) const {
+        return histograms[static_cast<size_t>(metric) * SLOTS + slot];
+    }
+    static int floorSlot(int floor, bool up) { return 1 + (floor - 1) * 2 + (up ? 0 : 1); }
+    static int hourSlot(SimTime requestTime) {
+        return 1 + FLOOR_SLOTS + static_cast<int>(requestTime / SimClock::TICKS_PER_HOUR % HOURS);
+    }
+    void record(Metric metric, const Passenger& passenger, SimTime ticks);
+
+public:
+    JourneyLatency();
+    void clear();
+    void merge(const JourneyLatency& other);
+
+    void recordBoarding(const Passenger& passenger, SimTime now);
+    // boardTime 为这组乘客的上车时刻
+    void recordArrival(const Passenger& passenger, SimTime boardTime, SimTime now);
+
+    const LatencyHistogram& overall(Metric metric) const { return at(metric, 0); }
+    const LatencyHistogram& byFloor(Metric metric, int floor, bool up) const {
+        return at(metric, floorSlot(floor, up));
+    }
+    const LatencyHistogram& byHour(Metric metric, int hour) const {
+        return at(metric, 1 + FLOOR_SLOTS + hour);
+    }
+    static const char* metricName(Metric metric);
+};
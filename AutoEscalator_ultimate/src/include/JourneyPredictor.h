@@ -0,0 +1,41 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "SimClock.h"
+#include "MotionModel.h"
+#include "ElevatorFleet.h"
+
+// 一次乘梯预测：派给哪部电梯、还要等多久、上车后坐多久（模拟秒）
+struct JourneyPrediction {
+    int car = -1;           // 没有可用电梯时为 -1
+    double time = 0.0;      // 预测所依据的时刻
+    double waitTime = 0.0;
+    double rideTime = 0.0;
+};
+
+// 供大堂目的层终端查询的乘梯时间预测。仿真线程在电梯组状态变化后发布一份只读快照
+// （按列存放的电梯组状态及其预计到达偏移、运行时间表），查询时原子地取得当前快照，
+// 只读计算，不改动仿真状态；快照发布后不再修改，多个查询线程可与仿真线程同时运行。
+// 快照对象循环复用：没有查询线程再持有的旧快照直接覆盖，发布时不必重新分配内存
+class JourneyPredictor {
+public:
+    struct Snapshot {
+        SimTime time = 0;
+        ElevatorFleet fleet;
+        std::shared_ptr<const MotionModel> motion;
+        ElevatorFleet::Filter filter = ElevatorFleet::Filter::AVAILABLE;
+        bool fallback = false;  // 按 filter 选不到电梯时退回任一可用电梯
+    };
+
+private:
+    std::shared_ptr<const Snapshot> current;
+    std::vector<std::shared_ptr<Snapshot>> pool;    // 仅仿真线程访问
+
+public:
+    // 取一份可以写入的快照：优先复用已无人引用的旧快照，其中的内容是旧的
+    std::shared_ptr<Snapshot> acquire();
+    void publish(std::shared_ptr<const Snapshot> snapshot);
+    bool ready() const;
+    // time 早于快照时刻时按快照时刻计
+    JourneyPrediction predict(int from, int to, SimTime time) const;
+};
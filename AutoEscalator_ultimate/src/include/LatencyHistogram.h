@@ -0,0 +1,41 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "BitOps.h"
+
+// HDR 风格的对数分桶直方图，数值为 tick。小于 2*SUB_BUCKETS 的值逐个计数，
+// 更大的值按所在的 2 的幂区间再等分 SUB_BUCKETS 个桶，相对误差不超过 1/SUB_BUCKETS。
+// 桶数固定，记录只需一次取最高位和一次加法；结构相同，逐桶相加即可合并
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKET_COUNT = (32 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+private:
+    std::array<uint32_t, BUCKET_COUNT> counts{};
+    uint64_t total = 0;
+    uint32_t maxValue = 0;
+
+    static int bucketOf(uint32_t value) {
+        if (value < 2 * SUB_BUCKETS) return static_cast<int>(value);
+        int shift = BitOps::highestBit64(value) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKETS + static_cast<int>(value >> shift);
+    }
+    // 桶内的最大值，分位数按它报告，宁可偏大不偏小
+    static uint32_t bucketHighest(int bucket);
+
+public:
+    void record(uint32_t value, uint32_t count = 1) {
+        counts[bucketOf(value)] += count;
+        total += count;
+        if (value > maxValue) maxValue = value;
+    }
+    void merge(const LatencyHistogram& other);
+    void clear();
+
+    uint64_t count() const { return total; }
+    uint32_t max() const { return maxValue; }
+    // fraction 取 0-1；没有记录时返回 0
+    uint32_t percentile(double fraction) const;
+};
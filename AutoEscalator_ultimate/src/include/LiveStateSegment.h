@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "Constants.h"
+
+// 共享内存状态段中一次发布的内容
+struct LiveStateData {
+    struct Car {
+        int8_t floor;
+        int8_t direction;       // 1 上行，-1 下行，0 无方向
+        uint8_t state;          // ElevatorState 的取值
+        uint8_t load;
+    };
+
+    int64_t simTicks;           // 模拟时刻（tick）
+    uint32_t carCount;
+    Car cars[ElevatorConfig::MAX_ELEVATOR_COUNT];     // 前 carCount 项有效
+    uint32_t upQueue[ElevatorConfig::FLOOR_COUNT];      // 各层候梯人数
+    uint32_t downQueue[ElevatorConfig::FLOOR_COUNT];
+};
+
+// 共享内存段的布局。头部在创建时写好，之后只有 sequence 和 data 会变化
+struct LiveStateLayout {
+    static constexpr uint32_t MAGIC = 0x4c564553;   // "SEVL"
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t floorCount;
+    uint32_t maxCars;
+    std::atomic<uint64_t> sequence;     // 顺序锁计数，奇数表示正在写
+    LiveStateData data;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "共享内存中的顺序锁计数须为无锁原子量");
+
+// 把电梯状态发布到 POSIX 共享内存段，外部监控程序映射同一段后随时读取，不需要系统调用，
+// 也不会阻塞仿真。写入用顺序锁：先把计数改成奇数，写完再改成偶数；读者在计数为偶数且
+// 复制前后不变时才采用读到的内容，否则重读。只有一个写者，写者从不等待读者。
+// 不支持 POSIX 共享内存的平台上 create、attach 直接返回 false
+class LiveStateSegment {
+private:
+    std::string name;
+    LiveStateLayout* layout = nullptr;
+    bool owner = false;     // 创建者关闭时删除共享内存段
+
+public:
+    LiveStateSegment() = default;
+    ~LiveStateSegment();
+    LiveStateSegment(const LiveStateSegment&) = delete;
+    LiveStateSegment& operator=(const LiveStateSegment&) = delete;
+
+    // 名称按 POSIX 约定以 / 开头，缺少时自动补上。同名段已存在时报错并返回 false
+    bool create(const std::string& segmentName);
+    bool attach(const std::string& segmentName);   // 只读映射，供监控程序使用
+    void close();
+    bool isOpen() const { return layout != nullptr; }
+    const std::string& getName() const { return name; }
+
+    void publish(const LiveStateData& data);
+    // 读取一份一致的快照；写者持续改写导致 maxRetries 次都没读成时返回 false
+    bool read(LiveStateData& out, int maxRetries = 1000) const;
+};
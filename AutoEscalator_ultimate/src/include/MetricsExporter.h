@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Constants.h"
+#include "Elevator.h"
+
+// 某一时刻的仿真指标，由仿真线程填写
+struct MetricsSnapshot {
+    struct Car {
+        int floor = 1;
+        int load = 0;
+        ElevatorState state = ElevatorState::IDLE;
+    };
+
+    double simulatedSeconds = 0.0;
+    std::chrono::steady_clock::time_point wallTime;
+    long long requests = 0;     // 已载入的请求人数
+    long long boarded = 0;
+    long long timeouts = 0;
+    std::vector<Car> cars;
+    std::array<int, ElevatorConfig::FLOOR_COUNT> upQueue{};     // 各层候梯人数
+    std::array<int, ElevatorConfig::FLOOR_COUNT> downQueue{};
+};
+
+// 定期把仿真指标写成 OpenMetrics 文本文件，供 node_exporter 文本文件采集器等读取。
+// 仿真线程只在自己的快照里填写，再在锁空闲时与待写快照交换，取不到锁就留到下次，
+// 从不等待；写文件线程按间隔取走最新快照，先写临时文件再改名替换，读者看不到写了一半的文件
+class MetricsExporter {
+private:
+    std::string path;
+    std::chrono::milliseconds interval;
+    std::chrono::steady_clock::time_point nextCapture;
+    MetricsSnapshot staged;         // 仅仿真线程访问
+    MetricsSnapshot pending;        // 以下受 mutex 保护
+    bool hasPending = false;
+    bool hasOrigin = false;
+    double originSeconds = 0.0;     // 第一次提交的时刻，首次写文件时据此计算运行速度
+    std::chrono::steady_clock::time_point originWall;
+    bool stopping = false;
+    bool failed = false;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread writer;
+
+    void run();
+    // speed 为模拟秒/墙钟秒
+    bool write(const MetricsSnapshot& snapshot, double speed) const;
+    void swapIn();
+
+public:
+    MetricsExporter(std::string filename, double intervalSeconds);
+    ~MetricsExporter();
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // 距上次提交已过采样间隔（写文件间隔的四分之一）
+    bool due() const { return std::chrono::steady_clock::now() >= nextCapture; }
+    MetricsSnapshot& stage() { return staged; }
+    // 提交 stage() 中填好的快照；写文件线程正在取快照时放弃这一次
+    void submit();
+    // 提交最后一份快照并等它写完，返回期间所有写入是否都成功
+    bool stop();
+};
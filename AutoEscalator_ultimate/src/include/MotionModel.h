@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include <cstdlib>
+#include "SimClock.h"
+
+// 电梯运行时间模型。按当前配置预先算出跨 0..FLOOR_COUNT-1 层的运行时间，查询为 O(1)。
+// 匀速模型每层耗时 FLOOR_TIME；运动学模型按加加速度、加速度、额定速度限制的 S 形曲线
+// 求闭式解，电梯一次出发直接运行到下一个停靠层
+class MotionModel {
+private:
+    bool kinematic;
+    SimTime doorTicks;
+    std::vector<SimTime> runTicks;      // 跨 d 层的运行时间
+    std::vector<SimTime> commitTicks;   // 出发后不晚于此刻仍可改为停靠距出发层 d 层的楼层
+
+public:
+    MotionModel();
+
+    // 从 ElevatorConfig 重新生成时间表，配置修改后调用
+    void rebuild();
+
+    bool isKinematic() const { return kinematic; }
+    SimTime doorTime() const { return doorTicks; }
+    SimTime travelTime(int fromFloor, int toFloor) const {
+        return runTicks[std::abs(toFloor - fromFloor)];
+    }
+    SimTime arrivalTime(SimTime departure, int fromFloor, int toFloor) const {
+        return departure + travelTime(fromFloor, toFloor);
+    }
+    // 出发 elapsed 之后是否还来得及在 floor 层停下
+    bool canStopAt(int fromFloor, int floor, SimTime elapsed) const {
+        return elapsed <= commitTicks[std::abs(floor - fromFloor)];
+    }
+
+    // 静止出发、静止到达走完 distance 米所需的秒数；brakeStart 返回运行曲线与全力运行曲线分开的时刻
+    static double runSeconds(double distance, double speed, double acceleration, double jerk,
+                             double* brakeStart = nullptr);
+};
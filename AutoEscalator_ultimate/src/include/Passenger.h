@@ -1,11 +1,61 @@
-#pragma once
-
-struct Passenger {
-    int sourceFloor;
-    int targetFloor;
-    double requestTime;
-    double waitTimeout;
-    
-    Passenger(int from, int to, double time, double timeout)
-        : sourceFloor(from), targetFloor(to), requestTime(time), waitTimeout(timeout) {}
-}; 
\ No newline at end of file
+#pragma once
+#include <cstdint>
+#include "SimClock.h"
+
+using PassengerHandle = uint32_t;
+
+// 召唤类别，数值越小越优先；各类别有自己的候梯时限目标
+enum class PriorityClass : uint8_t {
+    EMERGENCY,      // 消防、检修等紧急召唤
+    ACCESSIBILITY,  // 无障碍召唤
+    NORMAL
+};
+
+constexpr int PRIORITY_CLASS_COUNT = 3;
+
+enum class PassengerStatus : uint8_t {
+    FREE,
+    PENDING,
+    WAITING,
+    RIDING
+};
+
+// 同一请求的一组乘客只占一条记录，count 为组内人数。
+// 时间以 32 位 tick 保存，楼层和人数用窄整数，整条记录 20 字节
+struct Passenger {
+    uint32_t requestTick = 0;
+    // 候梯时为候梯时限；上车后时限不再需要，改记上车时刻
+    union {
+        uint32_t waitLimitTicks = 0;
+        uint32_t boardTick;
+    };
+    uint32_t serial = 0;    // 槽位每次回收加一，用于识别过期引用
+    uint8_t sourceFloor = 1;
+    uint8_t targetFloor = 1;
+    uint16_t count = 1;
+    PassengerStatus status = PassengerStatus::FREE;
+    uint8_t assignedCar = UNASSIGNED;   // 目的层派梯时分配到的电梯
+    PriorityClass priority = PriorityClass::NORMAL;
+
+    static constexpr uint8_t UNASSIGNED = 0xFF;
+    
+    Passenger() = default;
+    Passenger(int from, int to, SimTime time, SimTime timeout, int headcount = 1,
+              PriorityClass priorityClass = PriorityClass::NORMAL)
+        : requestTick(clampTicks(time))
+        , waitLimitTicks(clampTicks(timeout))
+        , sourceFloor(static_cast<uint8_t>(from))
+        , targetFloor(static_cast<uint8_t>(to))
+        , count(static_cast<uint16_t>(headcount))
+        , priority(priorityClass) {}
+
+    SimTime requestTime() const { return requestTick; }
+    SimTime deadline() const { return static_cast<SimTime>(requestTick) + waitLimitTicks; }
+
+    static uint32_t clampTicks(SimTime ticks) {
+        if (ticks <= 0) return 0;
+        return ticks >= UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(ticks);
+    }
+};
+
+static_assert(ElevatorConfig::FLOOR_COUNT <= 255, "楼层号用 uint8_t 保存");
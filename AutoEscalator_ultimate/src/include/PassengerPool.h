@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "Passenger.h"
+
+// 按块分配的乘客记录池，队列和电梯只保存 PassengerHandle
+class PassengerPool {
+public:
+    static constexpr size_t SLAB_SIZE = 4096;
+
+private:
+
+    std::vector<std::unique_ptr<Passenger[]>> slabs;
+    std::vector<PassengerHandle> freeList;
+    size_t usedSlots = 0;
+    size_t liveRecords = 0;
+
+public:
+    PassengerHandle allocate(const Passenger& passenger);
+    void release(PassengerHandle handle);
+    PassengerHandle split(PassengerHandle handle, int count);
+    void clear();
+
+    Passenger& operator[](PassengerHandle handle) {
+        return slabs[handle / SLAB_SIZE][handle % SLAB_SIZE];
+    }
+    const Passenger& operator[](PassengerHandle handle) const {
+        return slabs[handle / SLAB_SIZE][handle % SLAB_SIZE];
+    }
+
+    size_t liveCount() const { return liveRecords; }
+    size_t slotCapacity() const { return slabs.size() * SLAB_SIZE; }
+    size_t slabBytes() const { return slotCapacity() * sizeof(Passenger); }
+};
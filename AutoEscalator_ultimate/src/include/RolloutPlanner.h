@@ -0,0 +1,107 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "Constants.h"
+#include "SimClock.h"
+#include "MotionModel.h"
+
+// 前瞻模拟派梯：把当前系统压缩成一份快照，每个候选方案各复制一份可变部分，
+// 按简化的集选控制规则向前模拟一段时间，比较候梯总代价。
+// 候选方案分给线程池并行模拟，超过墙钟预算的方案放弃，只在已算完的方案中挑选
+class RolloutPlanner {
+public:
+    static constexpr int CARS = ElevatorConfig::MAX_ELEVATOR_COUNT;
+    static constexpr int FLOORS = ElevatorConfig::FLOOR_COUNT;
+    static constexpr int QUEUES = FLOORS * 2;
+    static constexpr int QUEUE_DEPTH = 16;      // 每条候梯队列只取前 16 组乘客
+
+    enum Phase : uint8_t { ARRIVE, DEPART };
+
+    struct CallGroup {
+        SimTime requestTime;
+        SimTime deadline;
+        uint16_t count;
+        uint8_t targetFloor;
+    };
+
+    // 模拟中会改变的部分：电梯状态按列存放，候梯乘客只记每条队列接走了多少，
+    // 复制一份只有几百字节
+    struct State {
+        std::array<SimTime, CARS> readyAt;      // 下一次到站或出发决策的时刻，NEVER 表示停用
+        std::array<uint32_t, CARS> stops;
+        std::array<std::array<uint8_t, FLOORS>, CARS> alight;
+        std::array<int8_t, CARS> floor;
+        std::array<int8_t, CARS> direction;
+        std::array<int8_t, CARS> target;        // 派梯目标，-1 表示没有
+        std::array<uint8_t, CARS> load;
+        std::array<Phase, CARS> phase;
+        std::array<uint8_t, QUEUES> head;       // 各队列已离开（上车或超时）的组数
+        std::array<uint16_t, QUEUES> headTaken; // 队首组已上车的人数
+        uint32_t upCalls;
+        uint32_t downCalls;
+        uint32_t claimed;                       // 已有运行中电梯负责的召唤层
+    };
+
+    // 只读部分在所有候选方案之间共享
+    struct Snapshot {
+        State start;
+        std::array<std::array<CallGroup, QUEUE_DEPTH>, QUEUES> calls;
+        std::array<uint8_t, QUEUES> queueLength;
+        SimTime now;
+        SimTime horizon;
+        int cars;
+    };
+
+    // car 为 -1 表示不派空闲电梯，把 floor 层的召唤留给运行中的电梯顺路接
+    struct Action {
+        int car;
+        int floor;
+    };
+
+private:
+    // 一次 choose 调用的任务；工作线程在锁内确认任务仍开放后复制一份再处理
+    struct Job {
+        const Snapshot* snapshot = nullptr;
+        const std::vector<Action>* actions = nullptr;
+        const MotionModel* motion = nullptr;
+        SimTime* results = nullptr;
+        int count = 0;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    Job job;
+    std::vector<SimTime> results;
+    std::atomic<int> nextAction{0};
+    std::atomic<bool> expired{false};
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    uint64_t jobId = 0;
+    bool jobOpen = false;   // choose 返回前关闭任务，迟醒的工作线程不再加入
+    int active = 0;         // 正在处理当前任务的工作线程数
+    bool stopping = false;
+
+    void workerLoop();
+    void drain(const Job& current);
+    void resizePool(int threads);
+    SimTime rollout(const Job& current, const Action& action);
+
+public:
+    RolloutPlanner() = default;
+    RolloutPlanner(const RolloutPlanner&) = delete;
+    RolloutPlanner& operator=(const RolloutPlanner&) = delete;
+    ~RolloutPlanner();
+
+    static int queueIndex(int floor, bool up) { return (floor - 1) * 2 + (up ? 0 : 1); }
+
+    // 返回代价最小的方案下标；预算内一个方案都没算完时返回 -1
+    int choose(const Snapshot& snapshot, const std::vector<Action>& actions, const MotionModel& motion);
+};
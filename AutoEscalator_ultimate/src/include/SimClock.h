@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <cstdio>
+#include "Constants.h"
+
+// 模拟内核使用的整数时钟：1 tick = 1 毫秒真实时间，1 模拟秒 = 1 小时 = 3600000 tick。
+// 浮点的模拟秒和 HH:MM:SS 只在输入输出处转换
+using SimTime = int64_t;
+
+namespace SimClock {
+    constexpr SimTime TICKS_PER_REAL_SECOND = 1000;
+    constexpr SimTime TICKS_PER_SIM_SECOND =
+        static_cast<SimTime>(ElevatorConfig::REAL_SECONDS_PER_SIM_SECOND) * TICKS_PER_REAL_SECOND;
+    constexpr SimTime TICKS_PER_HOUR = 3600 * TICKS_PER_REAL_SECOND;
+    constexpr SimTime NEVER = INT64_MAX;
+
+    inline SimTime fromSimSeconds(double simSeconds) {
+        return static_cast<SimTime>(std::llround(simSeconds * TICKS_PER_SIM_SECOND));
+    }
+
+    inline double toSimSeconds(SimTime ticks) {
+        return static_cast<double>(ticks) / TICKS_PER_SIM_SECOND;
+    }
+
+    inline SimTime fromClock(int hour, int minute, int second) {
+        return ((hour * 60LL + minute) * 60 + second) * TICKS_PER_REAL_SECOND;
+    }
+
+    inline std::string formatClock(SimTime ticks) {
+        long long seconds = ticks / TICKS_PER_REAL_SECOND;
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%02lld:%02lld:%02lld",
+                      seconds / 3600, (seconds / 60) % 60, seconds % 60);
+        return buffer;
+    }
+}
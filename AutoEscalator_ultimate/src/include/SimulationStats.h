@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <array>
+#include "Passenger.h"
+#include "LatencyHistogram.h"
+#include "JourneyLatency.h"
+#include "UtilizationTracker.h"
+
+// 一个直方图的分位数摘要，时间单位为模拟秒
+struct LatencySummary {
+    long long count = 0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+
+    static LatencySummary of(const LatencyHistogram& histogram) {
+        LatencySummary summary;
+        summary.count = static_cast<long long>(histogram.count());
+        summary.p50 = SimClock::toSimSeconds(histogram.percentile(0.50));
+        summary.p90 = SimClock::toSimSeconds(histogram.percentile(0.90));
+        summary.p99 = SimClock::toSimSeconds(histogram.percentile(0.99));
+        summary.max = SimClock::toSimSeconds(histogram.max());
+        return summary;
+    }
+};
+
+// 一次模拟结束后的统计快照，供界面输出和批处理结果文件共用
+struct SimulationStats {
+    std::vector<int> floorRequests;
+    std::vector<int> hourlyRequests;
+    int totalRequests = 0;
+    int timeoutRequests = 0;
+    double totalWaitTime = 0.0;
+    int strategySwitches = 0;
+    std::array<LatencyHistogram, PRIORITY_CLASS_COUNT> classWaits;     // 各类召唤的候梯时间，按人数计
+    std::array<int, PRIORITY_CLASS_COUNT> classWithinTarget{};          // 在本类时限目标内上车的人数
+    std::array<int, PRIORITY_CLASS_COUNT> classTimeouts{};
+    JourneyLatency journeys;    // 候梯、乘梯和全程时间的直方图，可与其他运行的结果合并
+    std::vector<CarUsage> carUsage;     // [电梯 * 24 + 小时]
+    double simulatedTime = 0.0;
+
+    double hourlyRate(int hour) const {
+        return totalRequests > 0 ?
+            (static_cast<double>(hourlyRequests[hour]) / totalRequests * 100) : 0.0;
+    }
+};
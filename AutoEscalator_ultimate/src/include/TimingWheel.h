@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "SimClock.h"
+#include "EventQueue.h"
+
+// 电梯事件使用的分层时间轮。每部电梯持有一个计时器，重新设定时直接从原槽位摘除，
+// 插入、取消和到期都是 O(1)。共 4 层、每层 256 槽，按到期时刻与当前时刻不同的最高字节分层，
+// 覆盖 2^32 tick（约 49 天），更远的计时器放在溢出链表中
+class TimingWheel {
+public:
+    static constexpr int LEVEL_BITS = 8;
+    static constexpr int SLOTS = 1 << LEVEL_BITS;
+    static constexpr int LEVELS = 4;
+
+private:
+    static constexpr int NONE = -1;
+    static constexpr int OVERFLOW_SLOT = LEVELS * SLOTS;
+    static constexpr int WORDS_PER_LEVEL = SLOTS / 64;
+
+    struct Timer {
+        SimTime when;
+        EventType type;
+        int prev;
+        int next;
+        int slot;       // 所在槽位（含层号），NONE 表示未设定
+    };
+
+    std::vector<Timer> timers;
+    std::vector<int> heads;             // 每个槽位一条双向链表，末尾一项为溢出链表
+    std::vector<int> tails;
+    std::vector<uint64_t> occupied;     // 非空槽位位图
+    SimTime now;
+    size_t armedCount;
+
+    void link(int id);
+    void unlink(int id);
+    void relinkSlot(int slot);
+    int findOccupied(int level, int from) const;
+    SimTime earliestIn(int slot) const;
+
+public:
+    explicit TimingWheel(size_t timerCount = 0);
+
+    void reset(size_t timerCount, SimTime start = 0);
+    // 设定计时器，已设定的计时器先被取消；when 不能早于当前时刻
+    void schedule(int id, SimTime when, EventType type);
+    void cancel(int id);
+    bool isArmed(int id) const { return timers[id].slot != NONE; }
+    SimTime expiry(int id) const { return timers[id].when; }
+    bool empty() const { return armedCount == 0; }
+    size_t size() const { return armedCount; }
+    SimTime nextTime() const;
+    // 推进当前时刻，调用方保证 time 不晚于 nextTime()
+    void advanceTo(SimTime time);
+    // 取出一个在当前时刻到期的计时器，没有时返回 false
+    bool popDue(int& id, EventType& type);
+};
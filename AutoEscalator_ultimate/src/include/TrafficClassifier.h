@@ -0,0 +1,43 @@
+#pragma once
+#include <array>
+#include <deque>
+#include <cstdint>
+#include "SimClock.h"
+
+enum class TrafficMode : uint8_t {
+    IDLE,           // 窗口内几乎没有乘客
+    UP_PEAK,        // 以从首层上行为主
+    DOWN_PEAK,      // 以下行到首层为主
+    LUNCH,          // 上下班两个方向的首层客流都很多
+    INTER_FLOOR     // 以层间客流为主
+};
+
+// 在线客流模式识别：最近 window 时长内的到达记录按时间排队，每条到达时记入三类客流
+// （从首层出发、到首层、层间）的人数，滑出窗口时从队首扣除，每次到达摊还 O(1)。
+// 模式变化需要持续一段时间才生效，避免在两种模式的边界上来回切换
+class TrafficClassifier {
+private:
+    enum Flow : uint8_t { FROM_LOBBY, TO_LOBBY, INTER, FLOW_COUNT };
+
+    struct Arrival {
+        SimTime time;
+        uint32_t count;
+        Flow flow;
+    };
+
+    std::deque<Arrival> arrivals;
+    std::array<int64_t, FLOW_COUNT> flowCounts{};
+    SimTime windowTicks = 1;
+    TrafficMode current = TrafficMode::IDLE;
+    TrafficMode pending = TrafficMode::IDLE;
+    SimTime pendingSince = 0;
+
+    TrafficMode classify() const;
+
+public:
+    void reset(SimTime window);
+    // 记录一组到达乘客并返回当前客流模式
+    TrafficMode record(SimTime time, int sourceFloor, int targetFloor, int count);
+    TrafficMode mode() const { return current; }
+    static const char* name(TrafficMode mode);
+};
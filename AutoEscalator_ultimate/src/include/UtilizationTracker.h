@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <vector>
+#include "SimClock.h"
+#include "Elevator.h"
+
+// 一部电梯在一段时间内的使用情况，时间为 tick
+struct CarUsage {
+    static constexpr int STATE_COUNT = 4;
+
+    std::array<SimTime, STATE_COUNT> stateTicks{};  // 按 ElevatorState 取下标
+    SimTime loadTicks = 0;      // 载客人数对时间的积分
+    int floors = 0;             // 运行经过的层数
+    int stops = 0;              // 运行途中停靠的次数
+    int doorCycles = 0;         // 开关门次数，含空闲电梯原地开门接客
+
+    SimTime ticks(ElevatorState state) const { return stateTicks[static_cast<int>(state)]; }
+    SimTime totalTicks() const;
+    void merge(const CarUsage& other);
+};
+
+// 按电梯、按小时累计的使用统计。只在电梯状态或载客数变化时记一次：把上次变化以来的
+// 一段按原状态和原载客数计入，跨整点的部分分到各自的小时
+class UtilizationTracker {
+public:
+    static constexpr int HOURS = 24;
+
+private:
+    struct CarTrack {
+        SimTime since = 0;
+        ElevatorState state = ElevatorState::IDLE;
+        int load = 0;
+    };
+
+    std::vector<CarTrack> tracks;
+    std::vector<CarUsage> usage;    // [电梯][小时]
+
+    static int hourOf(SimTime time) { return static_cast<int>(time / SimClock::TICKS_PER_HOUR % HOURS); }
+    static void close(const CarTrack& track, SimTime now, CarUsage* hours);
+
+public:
+    void reset(int cars, SimTime now);
+    void update(int car, SimTime now, ElevatorState state, int load);
+    void addTravel(int car, SimTime now, int floors) { usage[car * HOURS + hourOf(now)].floors += floors; }
+    void addDoorCycle(int car, SimTime now) { usage[car * HOURS + hourOf(now)].doorCycles++; }
+
+    int carCount() const { return static_cast<int>(tracks.size()); }
+    // 各电梯尚未结束的一段算到 now 为止，返回 [电梯][小时] 的统计
+    std::vector<CarUsage> report(SimTime now) const;
+};
@@ -1,16 +1,25 @@
-#include "UserInterface.h"
-#include "Logger.h"
-#include <filesystem>
-
-int main() {
-    std::filesystem::path dataPath = std::filesystem::current_path() / "data";
-    if (!std::filesystem::exists(dataPath)) {
-        std::filesystem::create_directory(dataPath);
-    }
-    
-    Logger::init("elevator.log");
-    UserInterface ui;
-    ui.showMainMenu();
-    Logger::close();
-    return 0;
-}
+#include "UserInterface.h"
+#include "BatchRunner.h"
+#include "Logger.h"
+#include <filesystem>
+
+int main(int argc, char* argv[]) {
+    std::filesystem::path dataPath = std::filesystem::current_path() / "data";
+    if (!std::filesystem::exists(dataPath)) {
+        std::filesystem::create_directory(dataPath);
+    }
+    
+    Logger::init("elevator.log");
+
+    if (argc > 1) {
+        BatchRunner runner;
+        int result = runner.parseArguments(argc, argv) ? runner.run() : 1;
+        Logger::close();
+        return result;
+    }
+
+    UserInterface ui;
+    ui.showMainMenu();
+    Logger::close();
+    return 0;
+}